@@ -1,9 +1,19 @@
 #include "Camera.h"
+#include "FrameReduction.h"
+#include "RealtimeScheduling.h"
+#include "ThreadPlacement.h"
 #include <QDebug>
+#include <algorithm>
+#include <chrono>
+#include <utility>
 
-Camera::Camera(const int id, QObject* parent ) :
-    QObject( parent ), m_id( id ), m_simulator( new CameraSimulatorLib ), m_is_connected( false ), m_is_running( false )
+Camera::Camera(const int id, std::unique_ptr<CameraBackend> backend, QObject* parent ) :
+    QObject( parent ), m_id( id ), m_backend( backend ? std::move( backend ) : CameraBackend::createDefault() ), m_is_connected( false ), m_is_running( false ),
+	m_parameters( std::make_shared<CameraParameters>() ),
+	m_reduction_pool( FramePool::create() )
 {
+	qRegisterMetaType<cv::Mat>( "cv::Mat" );
+	qRegisterMetaType<FramePacketPtr>( "FramePacketPtr" );
 }
 
 Camera::~Camera()
@@ -16,19 +26,101 @@ Camera::~Camera()
 	{
 		disconnect();
 	}
-	delete m_simulator;
+
+	// Frames still held by consumers return their buffers later; the pool deletes itself then
+	m_reduction_pool->retire();
 }
 
 bool Camera::connect()
+{
+	std::lock_guard<std::mutex> lifecycle( m_lifecycle_mutex );
+	if ( m_target_state == TargetState::Disconnected )
+	{
+		m_target_state = TargetState::Connected;
+	}
+	return connectBackend();
+}
+
+void Camera::disconnect()
+{
+	m_target_state = TargetState::Disconnected;
+	std::lock_guard<std::mutex> lifecycle( m_lifecycle_mutex );
+	disconnectBackend();
+}
+
+bool Camera::start()
+{
+	m_target_state = TargetState::Running;
+	std::lock_guard<std::mutex> lifecycle( m_lifecycle_mutex );
+	if ( !m_is_running )
+	{
+		m_frames_delivered = 0;
+		m_frames_dropped = 0;
+		m_frames_duplicated = 0;
+		m_frame_gaps = 0;
+	}
+	return startAcquisition();
+}
+
+void Camera::stop()
+{
+	if ( m_target_state == TargetState::Running )
+	{
+		m_target_state = TargetState::Connected;
+	}
+	std::lock_guard<std::mutex> lifecycle( m_lifecycle_mutex );
+	stopAcquisition();
+}
+
+bool Camera::recover()
+{
+	std::lock_guard<std::mutex> lifecycle( m_lifecycle_mutex );
+
+	// Re-read under the lock: a stop() or disconnect() that raced the watchdog wins
+	const TargetState target = m_target_state;
+	if ( target == TargetState::Disconnected )
+	{
+		return true;
+	}
+
+	const double exposure_time = m_capture_exposure_time;
+	const double gain = m_capture_gain;
+
+	disconnectBackend();
+	if ( !connectBackend() )
+	{
+		return false;
+	}
+
+	// connectBackend() picked up the backend defaults; restore what the camera ran with
+	setExposureTime( exposure_time );
+	setGain( gain );
+
+	return target != TargetState::Running || startAcquisition();
+}
+
+bool Camera::connectBackend()
 {
 	if ( m_is_connected )
 	{
 		return true;
 	}
 
-	if ( m_simulator->connect() )
+	bool ok = false;
+	{
+		std::lock_guard<std::mutex> lock( m_backend_mutex );
+		ok = m_backend->connect();
+		if ( ok )
+		{
+			m_capture_exposure_time = m_backend->getExposureTime();
+			m_capture_gain = m_backend->getGain();
+		}
+	}
+
+	if ( ok )
 	{
 		m_is_connected = true;
+		sampleParameters();
 		emit connectionStatusChanged( m_id, true );
 		qDebug() << "Camera" << m_id << "connected successfully";
 		return true;
@@ -40,25 +132,25 @@ bool Camera::connect()
 	}
 }
 
-void Camera::disconnect()
+void Camera::disconnectBackend()
 {
 	if ( !m_is_connected )
 	{
 		return;
 	}
 
-	if ( m_is_running )
+	stopAcquisition();
+
 	{
-		stop();
+		std::lock_guard<std::mutex> lock( m_backend_mutex );
+		m_backend->disconnect();
 	}
-
-	m_simulator->disconnect();
 	m_is_connected = false;
 	emit connectionStatusChanged( m_id, false );
 	qDebug() << "Camera" << m_id << "disconnected";
 }
 
-bool Camera::start()
+bool Camera::startAcquisition()
 {
 	if ( !m_is_connected )
 	{
@@ -71,9 +163,22 @@ bool Camera::start()
 		return true;
 	}
 
-	if ( m_simulator->start() )
+	// The thread of a run that reached the end of its stream is still to be joined
+	if ( m_end_of_stream )
+	{
+		stopAcquisition();
+	}
+
+	bool ok = false;
+	{
+		std::lock_guard<std::mutex> lock( m_backend_mutex );
+		ok = m_backend->start();
+	}
+
+	if ( ok )
 	{
 		m_is_running = true;
+		startAcquisitionThread();
 		qDebug() << "Camera" << m_id << "started acquisition";
 		return true;
 	}
@@ -84,15 +189,23 @@ bool Camera::start()
 	}
 }
 
-void Camera::stop()
+void Camera::stopAcquisition()
 {
-	if ( !m_is_running )
+	if ( !m_is_running && !m_end_of_stream )
 	{
 		return;
 	}
 
-	m_simulator->stop();
+	stopAcquisitionThread();
+
+	{
+		std::lock_guard<std::mutex> lock( m_backend_mutex );
+		m_backend->stop();
+	}
 	m_is_running = false;
+	m_end_of_stream = false;
+
+	m_frame_ring.clear();
 	qDebug() << "Camera" << m_id << "stopped acquisition";
 }
 
@@ -103,42 +216,328 @@ cv::Mat Camera::getFrame()
 		return {};
 	}
 
-	cv::Mat frame = m_simulator->getFrame();
-	if ( !frame.empty() )
+	const FramePacketPtr packet = latestPacket();
+	return packet ? packet->frame : cv::Mat();
+}
+
+FramePacketPtr Camera::latestPacket() const
+{
+	FramePacketPtr packet;
+	if ( !m_is_running || !m_frame_ring.readLatest( packet ) )
+	{
+		return nullptr;
+	}
+	return packet;
+}
+
+bool Camera::setCpuAffinity( const QVector<int>& cores )
+{
+	std::lock_guard<std::mutex> settings( m_thread_settings_mutex );
+	m_cpu_affinity = cores;
+	if ( cores.isEmpty() || !m_acquisition_thread.joinable() )
+	{
+		return true;
+	}
+
+	QString error;
+	if ( !ThreadPlacement::pin( m_acquisition_thread.native_handle(), cores, &error ) )
+	{
+		qWarning() << "[Camera]" << m_id << "cannot pin acquisition thread:" << error;
+		return false;
+	}
+	return true;
+}
+
+bool Camera::setAcquisitionSettings( const AcquisitionSettings& settings )
+{
+	if ( ( settings.binning != 1 && settings.binning != 2 && settings.binning != 4 ) || settings.decimation < 1 )
+	{
+		qWarning() << "[Camera]" << m_id << "invalid acquisition settings: binning" << settings.binning << "decimation"
+				   << settings.decimation;
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock( m_backend_mutex );
+
+	// A region of interest outside the frame would leave nothing to publish
+	if ( settings.reducesPixels() )
 	{
-		emit frameReady( m_id );
+		const cv::Size frame_size = m_backend->frameSize().empty() ? m_frame_size : m_backend->frameSize();
+		if ( !frame_size.empty() &&
+			 FrameReduction::effectiveRoi( frame_size, m_backend->pixelFormat(), settings ).empty() )
+		{
+			qWarning() << "[Camera]" << m_id << "region of interest" << settings.roi.x << settings.roi.y
+					   << settings.roi.width << settings.roi.height << "leaves no pixels of the"
+					   << frame_size.width << "x" << frame_size.height << "frame";
+			return false;
+		}
 	}
-    else if ( frame.empty()) {
-        qDebug() << "[Camera] frame empty";
-    }
-	return frame;
+
+	m_backend_reduces = m_backend->setAcquisitionSettings( settings );
+	m_acquisition_settings = settings;
+	m_reported_empty_reduction = false;
+	return true;
 }
 
-CameraParameters Camera::getParameters()
+AcquisitionSettings Camera::acquisitionSettings() const
+{
+	std::lock_guard<std::mutex> lock( m_backend_mutex );
+	return m_acquisition_settings;
+}
+
+bool Camera::setRealtimeScheduling( const RealtimeSchedulingConfig& config )
+{
+	const bool lock_memory = config.policy != RealtimeSchedulingConfig::Policy::Off && config.lock_memory;
+	m_reduction_pool->setLockMemory( lock_memory );
+	{
+		std::lock_guard<std::mutex> lock( m_backend_mutex );
+		m_backend->setLockMemory( lock_memory );
+	}
+
+	std::lock_guard<std::mutex> settings( m_thread_settings_mutex );
+	m_realtime = config;
+	if ( !m_acquisition_thread.joinable() )
+	{
+		return true;
+	}
+
+	QString error;
+	if ( !RealtimeScheduling::apply( m_acquisition_thread.native_handle(), config, &error ) )
+	{
+		qWarning() << "[Camera]" << m_id << "acquisition thread keeps normal scheduling:" << error;
+		return false;
+	}
+	return true;
+}
+
+void Camera::startAcquisitionThread()
+{
+	if ( m_acquiring.exchange( true ) )
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> settings( m_thread_settings_mutex );
+	m_acquisition_thread = std::thread( &Camera::acquisitionLoop, this );
+	QString error;
+	if ( !m_cpu_affinity.isEmpty() && !ThreadPlacement::pin( m_acquisition_thread.native_handle(), m_cpu_affinity, &error ) )
+	{
+		qWarning() << "[Camera]" << m_id << "cannot pin acquisition thread:" << error;
+	}
+	if ( m_realtime.policy != RealtimeSchedulingConfig::Policy::Off &&
+		 !RealtimeScheduling::apply( m_acquisition_thread.native_handle(), m_realtime, &error ) )
+	{
+		qWarning() << "[Camera]" << m_id << "acquisition thread keeps normal scheduling:" << error;
+	}
+}
+
+void Camera::stopAcquisitionThread()
+{
+	{
+		std::lock_guard<std::mutex> lock( m_acquisition_mutex );
+		m_acquiring = false;
+	}
+	m_acquisition_cv.notify_all();
+
+	std::lock_guard<std::mutex> settings( m_thread_settings_mutex );
+	if ( m_acquisition_thread.joinable() )
+	{
+		m_acquisition_thread.join();
+	}
+}
+
+void Camera::acquisitionLoop()
+{
+	using Clock = std::chrono::steady_clock;
+	auto next_deadline = Clock::now();
+
+	bool free_running = false;
+	bool end_of_stream = false;
+	bool reported_empty = false;
+	uint64_t last_counter = 0;
+	bool has_last = false;
+	uint64_t decimation_phase = 0;
+	AcquisitionSettings settings;
+	bool software_reduction = false;
+	while ( m_acquiring )
+	{
+		auto packet = std::make_shared<FramePacket>();
+		packet->camera_id = m_id;
+		packet->exposureTime = m_capture_exposure_time;
+		packet->gain = m_capture_gain;
+
+		// Slow-changing values come from the telemetry snapshot, not from a backend call per frame
+		{
+			const std::shared_ptr<const CameraParameters> parameters = std::atomic_load( &m_parameters );
+			packet->fps = parameters->fps;
+			packet->temperature = parameters->temperature;
+		}
+		{
+			std::lock_guard<std::mutex> lock( m_backend_mutex );
+			packet->frame = m_backend->getFrame();
+			packet->pixel_format = m_backend->pixelFormat();
+			packet->timestamp_ns =
+				std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now().time_since_epoch() ).count();
+			packet->frame_counter = m_backend->getFrameCounter();
+			if ( !m_backend_reduces && !packet->frame.empty() )
+			{
+				m_frame_size = packet->frame.size();
+			}
+			free_running = m_backend->isFreeRunning();
+			end_of_stream = m_backend->isEndOfStream();
+			settings = m_acquisition_settings;
+			software_reduction = !m_backend_reduces && settings.reducesPixels();
+		}
+		const double fps = packet->fps;
+		packet->stream_fps = fps / std::max( settings.decimation, 1 );
+		if ( packet->pixel_format == PixelFormat::Bgr8 && packet->frame.channels() == 1 )
+		{
+			packet->pixel_format = packet->frame.depth() == CV_16U ? PixelFormat::Mono16 : PixelFormat::Mono8;
+		}
+
+		// A repeated frame was processed already: skip it before any conversion or encoding
+		const bool empty_frame = packet->frame.empty();
+		const bool has_frame = !empty_frame && trackFrameCounter( packet->frame_counter, last_counter, has_last );
+
+		// Decimation and reduction before publishing, so no consumer sees the dropped pixels
+		bool publish = has_frame && decimation_phase++ % static_cast<uint64_t>( settings.decimation ) == 0;
+		if ( publish && software_reduction )
+		{
+			packet->frame = FrameReduction::apply( packet->frame, packet->pixel_format, settings, m_reduction_pool );
+
+			// Settings made before the frame size was known may crop everything: never publish an empty frame
+			if ( packet->frame.empty() )
+			{
+				publish = false;
+				if ( !m_reported_empty_reduction.exchange( true ) )
+				{
+					qWarning() << "[Camera]" << m_id << "region of interest leaves no pixels, frames are not published";
+				}
+			}
+		}
+
+		if ( publish )
+		{
+			const FramePacketPtr published = std::move( packet );
+			m_frame_ring.push( published );
+			emit frameAcquired( published );
+			emit frameReady( m_id );
+		}
+		else if ( empty_frame && end_of_stream )
+		{
+			// A finite source is done: finish the run, the thread is joined by the next stop() or start()
+			TargetState running = TargetState::Running;
+			m_target_state.compare_exchange_strong( running, TargetState::Connected );
+			m_end_of_stream = true;
+			m_is_running = false;
+			qDebug() << "[Camera]" << m_id << "reached the end of its stream";
+			break;
+		}
+		else if ( empty_frame && !reported_empty )
+		{
+			// Reported once per outage; recovery is up to the CameraWatchdog
+			qDebug() << "[Camera]" << m_id << "delivers empty frames";
+		}
+		if ( has_frame || empty_frame )
+		{
+			reported_empty = empty_frame;
+		}
+
+		// Free-running backends deliver the next frame right away; idle at the default pace when they have none
+		if ( free_running && has_frame )
+		{
+			next_deadline = Clock::now();
+			continue;
+		}
+
+		// Pace at the camera's own rate; after an overrun restart from now instead of bursting to catch up
+		const double rate = fps > 0.0 ? fps : kDefaultFps;
+		next_deadline += std::chrono::duration_cast<Clock::duration>( std::chrono::duration<double>( 1.0 / rate ) );
+		if ( const auto now = Clock::now(); next_deadline < now )
+		{
+			next_deadline = now;
+		}
+
+		std::unique_lock<std::mutex> lock( m_acquisition_mutex );
+		m_acquisition_cv.wait_until( lock, next_deadline, [this] { return !m_acquiring; } );
+	}
+}
+
+bool Camera::trackFrameCounter( const uint64_t counter, uint64_t& last_counter, bool& has_last )
+{
+	if ( has_last && counter == last_counter )
+	{
+		++m_frames_duplicated;
+		return false;
+	}
+
+	// A counter running backwards means the backend restarted; take it as the new baseline
+	if ( has_last && counter > last_counter + 1 )
+	{
+		m_frames_dropped += counter - last_counter - 1;
+		++m_frame_gaps;
+	}
+
+	last_counter = counter;
+	has_last = true;
+	++m_frames_delivered;
+	return true;
+}
+
+FrameStatistics Camera::frameStatistics() const
+{
+	FrameStatistics statistics;
+	statistics.delivered = m_frames_delivered;
+	statistics.dropped = m_frames_dropped;
+	statistics.duplicated = m_frames_duplicated;
+	statistics.gaps = m_frame_gaps;
+	return statistics;
+}
+
+CameraParameters Camera::getParameters() const
+{
+	return *std::atomic_load( &m_parameters );
+}
+
+bool Camera::sampleParameters( const bool wait )
 {
 	if ( !m_is_connected )
 	{
-		return m_parameters;
+		return false;
+	}
+
+	std::unique_lock<std::mutex> lock( m_backend_mutex, std::defer_lock );
+	if ( wait )
+	{
+		lock.lock();
+	}
+	else if ( !lock.try_lock() )
+	{
+		return false;
 	}
 
-	// Update parameters from simulator
-	m_parameters.temperature = m_simulator->getTemperature();
-	m_parameters.fps = m_simulator->getFPS();
-	m_parameters.exposureTime = m_simulator->getExposureTime();
-	m_parameters.gain = m_simulator->getGain();
-	m_parameters.power_status = m_simulator->getPowerStatus();
-	m_parameters.frame_counter = m_simulator->getFrameCounter();
-	m_parameters.error_code = m_simulator->getErrorCode();
+	auto parameters = std::make_shared<CameraParameters>();
+	parameters->temperature = m_backend->getTemperature();
+	parameters->fps = m_backend->getFPS();
+	parameters->exposureTime = m_backend->getExposureTime();
+	parameters->gain = m_backend->getGain();
+	parameters->power_status = m_backend->getPowerStatus();
+	parameters->frame_counter = m_backend->getFrameCounter();
+	parameters->error_code = m_backend->getErrorCode();
 
-	return m_parameters;
+	// Published under the lock so a concurrent setter is never overwritten by an older sample
+	std::atomic_store( &m_parameters, std::shared_ptr<const CameraParameters>( std::move( parameters ) ) );
+	return true;
 }
 
 void Camera::setExposureTime(const double value )
 {
 	if ( m_is_connected )
 	{
-		m_simulator->setExposureTime( value );
-		m_parameters.exposureTime = value;
+		std::lock_guard<std::mutex> lock( m_backend_mutex );
+		m_backend->setExposureTime( value );
+		updateParameters( [value]( CameraParameters& parameters ) { parameters.exposureTime = value; } );
+		m_capture_exposure_time = value;
 	}
 }
 
@@ -146,8 +545,10 @@ void Camera::setGain(const double value )
 {
 	if ( m_is_connected )
 	{
-		m_simulator->setGain( value );
-		m_parameters.gain = value;
+		std::lock_guard<std::mutex> lock( m_backend_mutex );
+		m_backend->setGain( value );
+		updateParameters( [value]( CameraParameters& parameters ) { parameters.gain = value; } );
+		m_capture_gain = value;
 	}
 }
 
@@ -155,7 +556,8 @@ void Camera::setPowerStatus(const bool on )
 {
 	if ( m_is_connected )
 	{
-		m_simulator->setPowerStatus( on );
-		m_parameters.power_status = on;
+		std::lock_guard<std::mutex> lock( m_backend_mutex );
+		m_backend->setPowerStatus( on );
+		updateParameters( [on]( CameraParameters& parameters ) { parameters.power_status = on; } );
 	}
 }
@@ -1,18 +1,40 @@
 #ifndef CAMERA_H
 #define CAMERA_H
 
-#include "../extern/CameraSimulator/CameraSimulatorLib.h"
+#include "AcquisitionSettings.h"
+#include "CameraBackend.h"
 #include "CameraParameters.h"
+#include "FramePacket.h"
+#include "FrameStatistics.h"
+#include "FramePool.h"
+#include "FrameRingBuffer.h"
+#include "RealtimeSchedulingConfig.h"
 #include <QObject>
 #include <QString>
+#include <QVector>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <opencv2/opencv.hpp>
 
+Q_DECLARE_METATYPE( cv::Mat )
+Q_DECLARE_METATYPE( FramePacketPtr )
+
 /**
  * @class Camera
- * @brief Wrapper for CameraSimulatorLib, represents a single camera
+ * @brief Represents a single camera on top of a CameraBackend
  *
  * This class manages a single camera instance, handling connection,
- * frame acquisition, and parameter management.
+ * frame acquisition, and parameter management. The frames and parameters
+ * come from a CameraBackend (vendor simulator or synthetic).
+ *
+ * While running, each camera owns an acquisition thread that pulls frames
+ * from the backend at the camera's own frame rate, wraps each one in a
+ * FramePacket and publishes it into its FrameRingBuffer and through
+ * frameAcquired(). Consumers never call
+ * into the backend to get a frame; they read the ring at their own pace.
  */
 class Camera : public QObject
 {
@@ -22,9 +44,10 @@ public:
 	/**
 	 * @brief Constructor
 	 * @param id Unique identifier for this camera
+	 * @param backend Source of frames and parameters, nullptr for CameraBackend::createDefault()
 	 * @param parent Parent QObject
 	 */
-	explicit Camera( int id, QObject* parent = nullptr );
+	explicit Camera( int id, std::unique_ptr<CameraBackend> backend = nullptr, QObject* parent = nullptr );
 
 	/**
 	 * @brief Destructor
@@ -40,8 +63,20 @@ public:
 		return m_id;
 	}
 
+	/**
+	 * @brief Get the name of the backend for logs
+	 */
+	QString backendName() const
+	{
+		return m_backend->name();
+	}
+
 	/**
 	 * @brief Connect to the camera
+	 *
+	 * connect(), disconnect(), start() and stop() may be called from any
+	 * thread; they are serialized with each other and with recover().
+	 *
 	 * @return true if successful
 	 */
 	bool connect();
@@ -52,16 +87,46 @@ public:
 	void disconnect();
 
 	/**
-	 * @brief Start frame acquisition
+	 * @brief Start frame acquisition and launch the acquisition thread
 	 * @return true if successful
 	 */
 	bool start();
 
 	/**
-	 * @brief Stop frame acquisition
+	 * @brief Stop frame acquisition and join the acquisition thread
 	 */
 	void stop();
 
+	/**
+	 * @brief Recover the camera to its target state after a failure
+	 *
+	 * Disconnects and reconnects the backend, restores exposure time and gain,
+	 * and restarts acquisition if the camera is meant to run. Does not change
+	 * the target state. Safe to call from any thread.
+	 *
+	 * @return true if the camera reached its target state
+	 */
+	bool recover();
+
+	/**
+	 * @enum TargetState
+	 * @brief State the camera was last asked to be in
+	 */
+	enum class TargetState
+	{
+		Disconnected,
+		Connected,
+		Running
+	};
+
+	/**
+	 * @brief Get the state the camera was last asked to be in by connect(), start(), stop() or disconnect()
+	 */
+	TargetState targetState() const
+	{
+		return m_target_state;
+	}
+
 	/**
 	 * @brief Check if camera is connected
 	 * @return true if connected
@@ -81,16 +146,111 @@ public:
 	}
 
 	/**
-	 * @brief Get the current frame from the camera
-	 * @return OpenCV Mat containing the frame
+	 * @brief Check whether the last run ended because the source has no more frames
+	 *
+	 * Set when a finite backend (e.g. a replay without loop) reaches its end:
+	 * the camera then stops running and its target state falls back to
+	 * Connected. Cleared by the next start() or stop().
+	 */
+	bool isEndOfStream() const
+	{
+		return m_end_of_stream;
+	}
+
+	/**
+	 * @brief Get the most recently acquired frame
+	 *
+	 * Does not call into the backend; the frame is shared (reference
+	 * counted) with every other consumer of the same acquisition.
+	 *
+	 * @return OpenCV Mat containing the frame, empty if none acquired yet
 	 */
 	cv::Mat getFrame();
 
 	/**
-	 * @brief Update and retrieve current camera parameters
-	 * @return CameraParameters struct with current values
+	 * @brief Get the most recently acquired frame with its capture metadata
+	 * @return Packet handle, nullptr if none acquired yet
+	 */
+	FramePacketPtr latestPacket() const;
+
+	/**
+	 * @brief Ring of recently acquired frames for consumers reading at their own pace
+	 * @return Frame ring filled by the acquisition thread
+	 */
+	const FrameRingBuffer& frameRing() const
+	{
+		return m_frame_ring;
+	}
+
+	/**
+	 * @brief Get the latest parameter snapshot
+	 *
+	 * Does not call into the backend; the values are as recent as the last
+	 * sampleParameters() call (see TelemetrySampler) or setter.
+	 *
+	 * @return CameraParameters struct with the cached values
+	 */
+	CameraParameters getParameters() const;
+
+	/**
+	 * @brief Read all parameters from the backend and publish them as the new snapshot
+	 * @param wait Wait for the backend if the acquisition thread is using it,
+	 *        otherwise keep the previous snapshot and return false
+	 * @return true if a new snapshot was published, false if busy or not connected
+	 */
+	bool sampleParameters( bool wait = true );
+
+	/**
+	 * @brief Get the delivery counters of the current acquisition
+	 *
+	 * Consecutive frames are compared by their backend frame counter: a jump
+	 * counts as dropped frames (and one gap), an unchanged counter as a
+	 * duplicate, which is not published at all. Reset by start().
+	 *
+	 * @return Counters; dispatch_dropped is not tracked by the camera
+	 */
+	FrameStatistics frameStatistics() const;
+
+	/**
+	 * @brief Reduce every acquired frame by region of interest, binning and decimation
+	 *
+	 * Region of interest and binning are done by the backend if it supports
+	 * them, otherwise right after getFrame(), before the frame is published.
+	 * Decimated frames count as delivered in frameStatistics() but are not
+	 * published. Takes effect with the next frame.
+	 *
+	 * @param settings Reduction; binning must be 1, 2 or 4, the region of interest must overlap the frame
+	 * @return false if the settings are invalid and were not applied
+	 */
+	bool setAcquisitionSettings( const AcquisitionSettings& settings );
+
+	/**
+	 * @brief Get the frame reduction in effect
+	 */
+	AcquisitionSettings acquisitionSettings() const;
+
+	/**
+	 * @brief Restrict the acquisition thread to a set of cores
+	 *
+	 * Applied right away if the camera is acquiring and again whenever the
+	 * acquisition thread is started.
+	 *
+	 * @param cores Core list, empty to leave new threads unpinned
+	 * @return false if pinning the running thread failed
 	 */
-	CameraParameters getParameters();
+	bool setCpuAffinity( const QVector<int>& cores );
+
+	/**
+	 * @brief Set the scheduling of the acquisition thread and the memory locking of the frame pool
+	 *
+	 * Applied right away if the camera is acquiring and again whenever the
+	 * acquisition thread is started. A thread that cannot be switched keeps
+	 * normal scheduling and a warning is logged.
+	 *
+	 * @param config Real-time mode, Policy::Off for normal scheduling
+	 * @return false if switching the running thread failed
+	 */
+	bool setRealtimeScheduling( const RealtimeSchedulingConfig& config );
 
 	/**
 	 * @brief Set exposure time
@@ -117,6 +277,12 @@ signals:
 	 */
 	void frameReady( int cameraId );
 
+	/**
+	 * @brief Emitted from the acquisition thread for every acquired frame
+	 * @param packet The acquired frame and its metadata
+	 */
+	void frameAcquired( const FramePacketPtr& packet );
+
 	/**
 	 * @brief Emitted when an error occurs
 	 * @param cameraId ID of this camera
@@ -133,11 +299,92 @@ signals:
 	void connectionStatusChanged( int cameraId, bool connected );
 
 private:
+	/**
+	 * @brief Connect the backend; call with m_lifecycle_mutex held
+	 */
+	bool connectBackend();
+
+	/**
+	 * @brief Stop acquisition and disconnect the backend; call with m_lifecycle_mutex held
+	 */
+	void disconnectBackend();
+
+	/**
+	 * @brief Start the backend and the acquisition thread; call with m_lifecycle_mutex held
+	 */
+	bool startAcquisition();
+
+	/**
+	 * @brief Stop the acquisition thread and the backend; call with m_lifecycle_mutex held
+	 */
+	void stopAcquisition();
+
+	/**
+	 * @brief Body of the acquisition thread, paced by the camera FPS
+	 */
+	void acquisitionLoop();
+
+	/**
+	 * @brief Launch the acquisition thread
+	 */
+	void startAcquisitionThread();
+
+	/**
+	 * @brief Signal the acquisition thread to stop and join it
+	 */
+	void stopAcquisitionThread();
+
+	/**
+	 * @brief Classify a frame against the previous one by frame counter and update the counters
+	 * @param counter Backend frame counter of the new frame
+	 * @param last_counter Counter of the previously delivered frame, updated
+	 * @param has_last false for the first frame of an acquisition, updated
+	 * @return false if the frame duplicates the previous one and must not be published
+	 */
+	bool trackFrameCounter( uint64_t counter, uint64_t& last_counter, bool& has_last );
+
+	/**
+	 * @brief Publish a copy of the snapshot with one field changed; call with m_backend_mutex held
+	 */
+	template <typename Update>
+	void updateParameters( Update update )
+	{
+		auto parameters = std::make_shared<CameraParameters>( *std::atomic_load( &m_parameters ) );
+		update( *parameters );
+		std::atomic_store( &m_parameters, std::shared_ptr<const CameraParameters>( std::move( parameters ) ) );
+	}
+
+	static constexpr double kDefaultFps = 30.0; ///< Pacing used while the backend reports no FPS
+
 	int m_id;						 ///< Camera identifier
-	CameraSimulatorLib* m_simulator; ///< Pointer to the simulator instance
-	bool m_is_connected;				 ///< Connection status
-	bool m_is_running;				 ///< Acquisition status
-	CameraParameters m_parameters;	 ///< Current camera parameters
+	std::unique_ptr<CameraBackend> m_backend; ///< Source of frames and parameters
+	std::atomic<bool> m_is_connected;	 ///< Connection status
+	std::atomic<bool> m_is_running;	 ///< Acquisition status
+	std::atomic<bool> m_end_of_stream { false }; ///< Run finished by the source, thread still to be joined
+	std::shared_ptr<const CameraParameters> m_parameters; ///< Latest parameter snapshot, swapped atomically
+
+	std::mutex m_lifecycle_mutex;			   ///< Serializes connect/disconnect/start/stop/recover
+	std::atomic<TargetState> m_target_state { TargetState::Disconnected }; ///< Last requested state
+	mutable std::mutex m_backend_mutex;		   ///< Serializes calls into the backend
+	std::thread m_acquisition_thread;		   ///< Per-camera acquisition thread
+	std::atomic<bool> m_acquiring { false };   ///< Keeps the acquisition thread alive
+	std::mutex m_acquisition_mutex;			   ///< Guards the pacing wait
+	std::mutex m_thread_settings_mutex;		   ///< Guards the thread settings below and applying them
+	QVector<int> m_cpu_affinity;			   ///< Cores of the acquisition thread, empty for any
+	RealtimeSchedulingConfig m_realtime;	   ///< Scheduling of the acquisition thread
+	std::condition_variable m_acquisition_cv;  ///< Wakes the acquisition thread on stop
+	FrameRingBuffer m_frame_ring;			   ///< Recently acquired frames
+	FramePool* m_reduction_pool;			   ///< Buffers of binned frames, retired on destruction
+	AcquisitionSettings m_acquisition_settings; ///< Frame reduction (m_backend_mutex)
+	bool m_backend_reduces = false;			   ///< Backend applies ROI and binning itself (m_backend_mutex)
+	cv::Size m_frame_size;								 ///< Full frame size last acquired (m_backend_mutex)
+	std::atomic<bool> m_reported_empty_reduction { false }; ///< Warned that the ROI leaves no pixels
+	std::atomic<double> m_capture_exposure_time { 0.0 }; ///< Exposure stamped into new packets
+	std::atomic<double> m_capture_gain { 0.0 };			 ///< Gain stamped into new packets
+	std::atomic<uint64_t> m_frames_delivered { 0 };		 ///< Frames published
+	std::atomic<uint64_t> m_frames_dropped { 0 };		 ///< Counter steps never delivered
+	std::atomic<uint64_t> m_frames_duplicated { 0 };	 ///< Frames skipped for an unchanged counter
+	std::atomic<uint64_t> m_frame_gaps { 0 };			 ///< Runs of dropped frames
 };
 
 #endif // CAMERA_H
@@ -0,0 +1,14 @@
+#include "CameraBackend.h"
+#include "SyntheticCameraBackend.h"
+#ifdef MULTICAM_HAVE_SIMULATOR
+#include "SimulatorCameraBackend.h"
+#endif
+
+std::unique_ptr<CameraBackend> CameraBackend::createDefault()
+{
+#ifdef MULTICAM_HAVE_SIMULATOR
+	return std::make_unique<SimulatorCameraBackend>();
+#else
+	return std::make_unique<SyntheticCameraBackend>();
+#endif
+}
@@ -0,0 +1,183 @@
+#ifndef CAMERABACKEND_H
+#define CAMERABACKEND_H
+
+#include "AcquisitionSettings.h"
+#include "PixelFormat.h"
+#include <QString>
+#include <cstdint>
+#include <memory>
+#include <opencv2/core.hpp>
+
+/**
+ * @class CameraBackend
+ * @brief Abstract source of frames and parameters underneath a Camera
+ *
+ * Camera only talks to this interface, so the vendor simulator library can be
+ * swapped for an in-process implementation (see SyntheticCameraBackend).
+ * Implementations need not be thread-safe; Camera serializes every call.
+ */
+class CameraBackend
+{
+public:
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~CameraBackend() = default;
+
+	/**
+	 * @brief Create the backend used when none is given explicitly
+	 *
+	 * The vendor simulator if the build has it, the synthetic backend otherwise.
+	 *
+	 * @return New backend
+	 */
+	static std::unique_ptr<CameraBackend> createDefault();
+
+	/**
+	 * @brief Get a short name of the backend for logs
+	 */
+	virtual QString name() const = 0;
+
+	/**
+	 * @brief Connect the camera
+	 * @return true if successful
+	 */
+	virtual bool connect() = 0;
+
+	/**
+	 * @brief Disconnect the camera
+	 */
+	virtual void disconnect() = 0;
+
+	/**
+	 * @brief Start frame acquisition
+	 * @return true if successful
+	 */
+	virtual bool start() = 0;
+
+	/**
+	 * @brief Stop frame acquisition
+	 */
+	virtual void stop() = 0;
+
+	/**
+	 * @brief Get the next frame
+	 * @return Frame, empty if none is available
+	 */
+	virtual cv::Mat getFrame() = 0;
+
+	/**
+	 * @brief Get the sensor temperature in °C
+	 */
+	virtual double getTemperature() const = 0;
+
+	/**
+	 * @brief Get the frame rate in frames per second
+	 */
+	virtual double getFPS() const = 0;
+
+	/**
+	 * @brief Check whether frames should be pulled as fast as possible
+	 *
+	 * A free-running backend is not paced by getFPS(); Camera requests the
+	 * next frame as soon as the previous one is published.
+	 */
+	virtual bool isFreeRunning() const
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Check whether a finite source delivered its last frame
+	 *
+	 * The empty frames that follow are then the normal end of acquisition,
+	 * not a failure; Camera finishes its run instead of waiting for frames.
+	 */
+	virtual bool isEndOfStream() const
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Layout of the frames returned by getFrame()
+	 *
+	 * Single-channel frames of a backend reporting Bgr8 are taken as Mono8 or
+	 * Mono16 by their depth.
+	 */
+	virtual PixelFormat pixelFormat() const
+	{
+		return PixelFormat::Bgr8;
+	}
+
+	/**
+	 * @brief Size of a full frame, before any region of interest or binning
+	 * @return Empty if unknown; the Camera then learns it from the frames it acquires
+	 */
+	virtual cv::Size frameSize() const
+	{
+		return cv::Size();
+	}
+
+	/**
+	 * @brief Apply region of interest and binning on the device, so fewer pixels are read out
+	 * @param settings Reduction requested by the Camera; decimation is always done by the Camera
+	 * @return true if getFrame() now delivers reduced frames, false to let the Camera reduce them
+	 */
+	virtual bool setAcquisitionSettings( const AcquisitionSettings& /*settings*/ )
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Lock the buffers of delivered frames into RAM, if the backend pools them
+	 * @param lock true to lock, false to stop locking new buffers
+	 */
+	virtual void setLockMemory( bool /*lock*/ )
+	{
+	}
+
+	/**
+	 * @brief Get the exposure time in µs
+	 */
+	virtual double getExposureTime() const = 0;
+
+	/**
+	 * @brief Set the exposure time
+	 * @param value Exposure time in µs
+	 */
+	virtual void setExposureTime( double value ) = 0;
+
+	/**
+	 * @brief Get the gain factor
+	 */
+	virtual double getGain() const = 0;
+
+	/**
+	 * @brief Set the gain factor
+	 * @param value Gain factor
+	 */
+	virtual void setGain( double value ) = 0;
+
+	/**
+	 * @brief Get the power status
+	 */
+	virtual bool getPowerStatus() const = 0;
+
+	/**
+	 * @brief Set the power status
+	 * @param on true to power on, false to power off
+	 */
+	virtual void setPowerStatus( bool on ) = 0;
+
+	/**
+	 * @brief Get the number of frames captured so far
+	 */
+	virtual uint64_t getFrameCounter() const = 0;
+
+	/**
+	 * @brief Get the error code (0 = no error)
+	 */
+	virtual int getErrorCode() const = 0;
+};
+
+#endif // CAMERABACKEND_H
@@ -0,0 +1,180 @@
+#include "CameraWatchdog.h"
+#include "Camera.h"
+#include <algorithm>
+
+CameraWatchdog::CameraWatchdog( QObject* parent ) : QObject( parent ), m_random( std::random_device {}() )
+{
+	m_thread = std::thread( &CameraWatchdog::supervisionLoop, this );
+}
+
+CameraWatchdog::~CameraWatchdog()
+{
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		m_stopping = true;
+	}
+	m_wake.notify_all();
+
+	if ( m_thread.joinable() )
+	{
+		m_thread.join();
+	}
+
+	// The futures of std::async block until their recovery has returned
+	m_cameras.clear();
+}
+
+void CameraWatchdog::watch( Camera* camera )
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	if ( m_cameras.find( camera ) == m_cameras.end() )
+	{
+		Supervision& supervision = m_cameras[camera];
+		supervision.last_progress = Clock::now();
+	}
+}
+
+void CameraWatchdog::unwatch( Camera* camera )
+{
+	std::future<bool> recovery;
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		const auto it = m_cameras.find( camera );
+		if ( it == m_cameras.end() )
+		{
+			return;
+		}
+		recovery = std::move( it->second.recovery );
+		m_cameras.erase( it );
+	}
+
+	// Wait outside the lock so the other cameras stay supervised meanwhile
+	if ( recovery.valid() )
+	{
+		recovery.wait();
+	}
+}
+
+void CameraWatchdog::supervisionLoop()
+{
+	std::unique_lock<std::mutex> lock( m_mutex );
+	while ( !m_stopping )
+	{
+		const auto now = Clock::now();
+		for ( auto& [camera, supervision] : m_cameras )
+		{
+			check( camera, supervision, now );
+		}
+		m_wake.wait_for( lock, std::chrono::milliseconds( kCheckIntervalMs ), [this] { return m_stopping; } );
+	}
+}
+
+void CameraWatchdog::check( Camera* camera, Supervision& supervision, const Clock::time_point now )
+{
+	const int id = camera->getId();
+
+	// A running recovery is polled, never waited for: one hanging camera must not hold up the others
+	if ( supervision.recovery.valid() )
+	{
+		if ( supervision.recovery.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+		{
+			return;
+		}
+
+		const bool ok = supervision.recovery.get();
+		const auto delay = backoff( supervision.attempts );
+		supervision.last_delivered = camera->frameStatistics().delivered;
+		supervision.last_progress = now;
+		supervision.next_attempt = now + delay;
+		if ( !ok )
+		{
+			emit recoveryFailed(
+				id, supervision.attempts,
+				static_cast<int>( std::chrono::duration_cast<std::chrono::milliseconds>( delay ).count() ) );
+		}
+		// On success the camera stays unhealthy until it delivers frames again; a relapse backs off as well
+		return;
+	}
+
+	// A finite source that played to its end finished normally, there is nothing to recover
+	const Camera::TargetState target = camera->targetState();
+	if ( target == Camera::TargetState::Disconnected || camera->isEndOfStream() )
+	{
+		supervision.unhealthy = false;
+		supervision.attempts = 0;
+		supervision.last_progress = now;
+		return;
+	}
+
+	const CameraParameters parameters = camera->getParameters();
+	const uint64_t delivered = camera->frameStatistics().delivered;
+
+	// Without an FPS reading fall back to the minimum; a powered-off camera is not expected to deliver
+	const int stall_timeout_ms =
+		parameters.fps > 0.0 ? std::max( static_cast<int>( kStallFrames * 1000.0 / parameters.fps ), kMinStallTimeoutMs )
+							 : kMinStallTimeoutMs;
+	const bool expects_frames = target == Camera::TargetState::Running && parameters.power_status;
+
+	QString reason;
+	if ( !camera->isConnected() )
+	{
+		reason = "not connected";
+	}
+	else if ( target == Camera::TargetState::Running && !camera->isRunning() )
+	{
+		reason = "acquisition not running";
+	}
+	else if ( parameters.error_code != 0 )
+	{
+		reason = QString( "error code %1" ).arg( parameters.error_code );
+	}
+	else if ( expects_frames && delivered == supervision.last_delivered )
+	{
+		reason = QString( "no frame for %1 ms" ).arg( stall_timeout_ms );
+	}
+	else
+	{
+		supervision.last_delivered = delivered;
+		supervision.last_progress = now;
+		if ( supervision.unhealthy )
+		{
+			emit cameraRecovered( id, supervision.attempts );
+		}
+		supervision.unhealthy = false;
+		supervision.attempts = 0;
+		return;
+	}
+
+	// Transient hiccups (a connect in progress, a late frame) are given the stall timeout to clear
+	if ( now - supervision.last_progress < std::chrono::milliseconds( stall_timeout_ms ) )
+	{
+		return;
+	}
+
+	if ( !supervision.unhealthy )
+	{
+		supervision.unhealthy = true;
+		supervision.next_attempt = now;
+		emit cameraUnhealthy( id, reason );
+	}
+
+	if ( now < supervision.next_attempt )
+	{
+		return;
+	}
+
+	++supervision.attempts;
+	emit recoveryStarted( id, supervision.attempts );
+	supervision.recovery = std::async( std::launch::async, [camera] { return camera->recover(); } );
+}
+
+CameraWatchdog::Clock::duration CameraWatchdog::backoff( const int attempts )
+{
+	// 500 ms, 1 s, 2 s, ... capped at 30 s, spread by +-50% so cameras failing together do not retry together
+	const int exponent = std::min( std::max( attempts - 1, 0 ), 16 );
+	const double base_ms = std::min( static_cast<double>( kBackoffBaseMs ) * ( 1 << exponent ),
+									 static_cast<double>( kBackoffMaxMs ) );
+	std::uniform_real_distribution<double> jitter( 0.5, 1.5 );
+	return std::chrono::duration_cast<Clock::duration>(
+		std::chrono::duration<double, std::milli>( base_ms * jitter( m_random ) ) );
+}
@@ -0,0 +1,135 @@
+#ifndef CAMERAWATCHDOG_H
+#define CAMERAWATCHDOG_H
+
+#include <QObject>
+#include <QString>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+
+class Camera;
+
+/**
+ * @class CameraWatchdog
+ * @brief Background supervisor reconnecting failed or stalled cameras
+ *
+ * A camera is unhealthy when it is not in its target state (e.g. connect()
+ * failed), reports a non-zero error code, or delivers no new frame for
+ * kStallFrames frame periods while it should be running. After the problem
+ * persisted for the stall timeout, Camera::recover() runs on a helper
+ * thread. Failed attempts are retried with jittered exponential backoff.
+ * Each camera is checked and recovered on its own, so healthy cameras keep
+ * streaming undisturbed.
+ *
+ * The signals are emitted from the watchdog's threads.
+ */
+class CameraWatchdog : public QObject
+{
+	Q_OBJECT
+
+public:
+	static constexpr int kCheckIntervalMs = 200;	   ///< Period of the health check
+	static constexpr int kStallFrames = 10;		   ///< Missing frame periods that count as a stall
+	static constexpr int kMinStallTimeoutMs = 1000;	   ///< Lower bound of the stall timeout
+	static constexpr int kBackoffBaseMs = 500;		   ///< Delay before the second attempt
+	static constexpr int kBackoffMaxMs = 30000;		   ///< Upper bound of the backoff delay
+
+	/**
+	 * @brief Constructor, starts the supervision thread
+	 * @param parent Parent QObject
+	 */
+	explicit CameraWatchdog( QObject* parent = nullptr );
+
+	/**
+	 * @brief Destructor, stops supervision and waits for running recoveries
+	 */
+	~CameraWatchdog() override;
+
+	/**
+	 * @brief Supervise a camera
+	 * @param camera Camera, must stay alive until unwatch()
+	 */
+	void watch( Camera* camera );
+
+	/**
+	 * @brief Stop supervising a camera; returns once no recovery of it is running
+	 * @param camera Camera to release
+	 */
+	void unwatch( Camera* camera );
+
+signals:
+	/**
+	 * @brief Emitted when a camera is found unhealthy
+	 * @param cameraId Camera ID
+	 * @param reason Human readable cause
+	 */
+	void cameraUnhealthy( int cameraId, const QString& reason );
+
+	/**
+	 * @brief Emitted before a recovery attempt
+	 * @param cameraId Camera ID
+	 * @param attempt Number of the attempt, starting at 1
+	 */
+	void recoveryStarted( int cameraId, int attempt );
+
+	/**
+	 * @brief Emitted after a failed recovery attempt
+	 * @param cameraId Camera ID
+	 * @param attempt Number of the attempt
+	 * @param retryInMs Delay until the next attempt
+	 */
+	void recoveryFailed( int cameraId, int attempt, int retryInMs );
+
+	/**
+	 * @brief Emitted once a recovered camera delivers frames again
+	 * @param cameraId Camera ID
+	 * @param attempts Attempts it took
+	 */
+	void cameraRecovered( int cameraId, int attempts );
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * @struct Supervision
+	 * @brief Health tracking of one camera
+	 */
+	struct Supervision
+	{
+		uint64_t last_delivered = 0;		 ///< Delivered frame count at the last progress
+		Clock::time_point last_progress;	 ///< Last time the camera was healthy or made progress
+		bool unhealthy = false;				 ///< Problem reported, recovery pending
+		int attempts = 0;					 ///< Recovery attempts since the camera was last healthy
+		Clock::time_point next_attempt;		 ///< Earliest time of the next attempt
+		std::future<bool> recovery;			 ///< Running recovery, if any
+	};
+
+	/**
+	 * @brief Body of the supervision thread
+	 */
+	void supervisionLoop();
+
+	/**
+	 * @brief Check one camera and start its recovery if due; call with m_mutex held
+	 */
+	void check( Camera* camera, Supervision& supervision, Clock::time_point now );
+
+	/**
+	 * @brief Jittered exponential backoff after a number of failed attempts
+	 */
+	Clock::duration backoff( int attempts );
+
+	std::map<Camera*, Supervision> m_cameras; ///< Supervised cameras (m_mutex)
+	std::mutex m_mutex;						  ///< Guards m_cameras and m_stopping
+	std::condition_variable m_wake;			  ///< Wakes the thread on stop
+	bool m_stopping = false;				  ///< Set on destruction (m_mutex)
+	std::mt19937 m_random;					  ///< Backoff jitter
+	std::thread m_thread;					  ///< Supervision thread
+};
+
+#endif // CAMERAWATCHDOG_H
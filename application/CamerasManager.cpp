@@ -1,9 +1,14 @@
 #include "CamerasManager.h"
+#include "ReplayCameraBackend.h"
+#include "SyntheticCameraBackend.h"
 #include <QDebug>
 #include <QDateTime>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 CamerasManager::CamerasManager( QObject* parent )
-    : QObject( parent ), m_next_camera_id( 0 ), m_auto_update_enabled( false ), m_parameter_logging_enabled( false ), m_videoSaver(VideoSaver(this))
+    : QObject( parent ), m_auto_update_enabled( false ), m_parameter_logging_enabled( false ), m_videoSaver(VideoSaver(this))
 {
 	m_auto_update_timer = new QTimer( this );
 	connect( m_auto_update_timer, &QTimer::timeout, this, &CamerasManager::onAutoUpdateTimer );
@@ -11,20 +16,56 @@ CamerasManager::CamerasManager( QObject* parent )
 	m_parameter_log_timer = new QTimer( this );
 	connect( m_parameter_log_timer, &QTimer::timeout, this, &CamerasManager::onParameterLogTimer );
 
-    m_videoSaver.configureCameras(m_cameras.keys());
+    m_dispatcher.setExecutor(&m_executor);
+    reconfigureVideoSaver();
+
+	m_dispatcher.addConsumer("Display", [this](const FramePacketPtr &packet) {
+		m_display_packets[packet->camera_id] = packet;
+	});
+
+	qRegisterMetaType<FrameSet>("FrameSet");
+	qRegisterMetaType<CameraStartupReport>("CameraStartupReport");
+	m_synchronizer.setCallback([this](const FrameSet &set) { emit frameSetReady(set); });
+	m_dispatcher.addConsumer("Synchronizer", [this](const FramePacketPtr &packet) {
+		if (m_synchronizer.isActive())
+		{
+			m_synchronizer.push(packet);
+		}
+	});
+
+	// Emitted from the watchdog thread, so these arrive queued on the manager's thread
+	connect(&m_watchdog, &CameraWatchdog::cameraUnhealthy, this, [this](const int cameraId, const QString &reason) {
+		addLog(LogLevel::Warning, QString("Camera %1 unhealthy: %2").arg(cameraId).arg(reason), cameraId);
+	});
+	connect(&m_watchdog, &CameraWatchdog::recoveryStarted, this, [this](const int cameraId, const int attempt) {
+		addLog(LogLevel::Info, QString("Recovering camera %1 (attempt %2)").arg(cameraId).arg(attempt), cameraId);
+	});
+	connect(&m_watchdog, &CameraWatchdog::recoveryFailed, this, [this](const int cameraId, const int attempt, const int retryInMs) {
+		addLog(LogLevel::Warning, QString("Recovery of camera %1 failed (attempt %2), retrying in %3 ms").arg(cameraId).arg(attempt).arg(retryInMs), cameraId);
+	});
+	connect(&m_watchdog, &CameraWatchdog::cameraRecovered, this, [this](const int cameraId, const int attempts) {
+		addLog(LogLevel::Info, QString("Camera %1 recovered after %2 attempt(s)").arg(cameraId).arg(attempts), cameraId);
+	});
 
 	addLog(LogLevel::Info, "CamerasManager initialized");
 }
 
 CamerasManager::~CamerasManager()
 {
+	waitForStartup();
+	for (auto *camera : m_cameras)
+	{
+		m_watchdog.unwatch(camera);
+	}
+	stopRecording();
 	stopAll();
 	disconnectAll();
 	stopParameterLogging();
 
 	// Clean up all cameras
-	for (const auto *camera : m_cameras)
+	for (auto *camera : m_cameras)
 	{
+		m_telemetry.removeCamera(camera);
 		delete camera;
 	}
 	m_cameras.clear();
@@ -32,21 +73,57 @@ CamerasManager::~CamerasManager()
 	addLog(LogLevel::Info, "CamerasManager destroyed");
 }
 
-int CamerasManager::addCamera()
+int CamerasManager::addCamera(std::unique_ptr<CameraBackend> backend)
 {
-	const int cameraId = m_next_camera_id++;
-	const auto camera = new Camera(cameraId, this);
+	const int cameraId = m_cameras.nextHandle();
+	if (cameraId < 0)
+	{
+		addLog(LogLevel::Error, "Cannot add camera: camera limit reached");
+		return -1;
+	}
+	const auto camera = new Camera(cameraId, std::move(backend), this);
 
 	// Connect signals
 	connect(camera, &Camera::errorOccurred, this, &CamerasManager::onCameraError);
 	connect(camera, &Camera::connectionStatusChanged, this, &CamerasManager::onConnectionStatusChanged);
+	connect(camera, &Camera::frameAcquired, this, &CamerasManager::frameAcquired, Qt::DirectConnection);
 
-	m_cameras[cameraId] = camera;
+	m_cameras.insert(camera);
+	m_telemetry.addCamera(camera);
+	m_watchdog.watch(camera);
+	if (m_realtime.policy != RealtimeSchedulingConfig::Policy::Off)
+	{
+		camera->setRealtimeScheduling(m_realtime);
+	}
 
-	addLog(LogLevel::Info, QString("Camera added with ID %1").arg(cameraId), cameraId);
+	addLog(LogLevel::Info, QString("Camera added with ID %1 (%2 backend)").arg(cameraId).arg(camera->backendName()), cameraId);
 	emit cameraAdded(cameraId);
-	m_videoSaver.configureCameras(m_cameras.keys());
+	reconfigureVideoSaver();
+	applyThreadPlacement();
+
+	return cameraId;
+}
+
+QVector<int> CamerasManager::addSyntheticCameras(const int count, const SyntheticCameraConfig &config)
+{
+	QVector<int> ids;
+	ids.reserve(count);
+	for (int i = 0; i < count; ++i)
+	{
+		SyntheticCameraConfig cameraConfig = config;
+		if (cameraConfig.seed != 0)
+		{
+			cameraConfig.seed += static_cast<uint32_t>(i);
+		}
+		ids.append(addCamera(std::make_unique<SyntheticCameraBackend>(cameraConfig)));
+	}
+	return ids;
+}
 
+int CamerasManager::addReplayCamera(const ReplayCameraConfig &config)
+{
+	const int cameraId = addCamera(std::make_unique<ReplayCameraBackend>(config));
+	addLog(LogLevel::Info, QString("Replaying %1").arg(config.path), cameraId);
 	return cameraId;
 }
 
@@ -58,28 +135,54 @@ bool CamerasManager::removeCamera(const int cameraId)
 		return false;
 	}
 
-	Camera *camera = m_cameras[cameraId];
+	// A bring-up task may still be using the camera; its queued report is dropped as the camera is gone
+	bool startupPending = false;
+	if (const auto pending = m_pending_startups.find(cameraId); pending != m_pending_startups.end())
+	{
+		pending->second.wait();
+		m_pending_startups.erase(pending);
+		startupPending = true;
+	}
+
+	Camera *camera = getCamera(cameraId);
+	m_watchdog.unwatch(camera);
+	m_telemetry.removeCamera(camera);
 	camera->stop();
 	camera->disconnect();
 
-	m_cameras.remove(cameraId);
+	m_cameras.erase(cameraId);
+	m_dispatcher.removeCamera(cameraId);
+	m_display_packets.remove(cameraId);
+	if (m_synchronizer.cameraIds().contains(cameraId))
+	{
+		QVector<int> group = m_synchronizer.cameraIds();
+		group.removeAll(cameraId);
+		setSyncGroup(group, m_sync_tolerance_ms);
+	}
 	delete camera;
 
 	addLog(LogLevel::Info, QString("Camera removed"), cameraId);
 	emit cameraRemoved(cameraId);
-	m_videoSaver.configureCameras(m_cameras.keys());
+
+	// Receivers of cameraRemoved (the preview) are done with the camera; wait out its queued encoding
+	m_executor.dropStrands(cameraId);
+	m_placed_cores.remove(cameraId);
+	reconfigureVideoSaver();
+	applyThreadPlacement();
+
+	// The removed camera may have been the last one the bring-up waited for
+	if (startupPending && m_pending_startups.empty())
+	{
+		finishStartup();
+	}
 
 	return true;
 }
 
 Camera *CamerasManager::getCamera(int cameraId) const
 {
-	return m_cameras.value(cameraId, nullptr);
-}
-
-QVector<int> CamerasManager::getCameraIds() const
-{
-	return m_cameras.keys().toVector();
+	Camera *const *camera = m_cameras.find(cameraId);
+	return camera ? *camera : nullptr;
 }
 
 bool CamerasManager::connectAll()
@@ -158,6 +261,170 @@ void CamerasManager::stopAll()
 	addLog(LogLevel::Info, "All cameras stopped");
 }
 
+void CamerasManager::connectAllAsync()
+{
+	bringUpAllAsync(false);
+}
+
+void CamerasManager::startAllAsync()
+{
+	bringUpAllAsync(true);
+}
+
+void CamerasManager::bringUpAllAsync(const bool start)
+{
+	if (isStartupInProgress())
+	{
+		addLog(LogLevel::Warning, "Camera startup already in progress");
+		return;
+	}
+
+	addLog(LogLevel::Info, QString("%1 %2 cameras concurrently...")
+		.arg(start ? "Connecting and starting" : "Connecting")
+		.arg(m_cameras.size()));
+
+	m_startup_reports.clear();
+	m_startup_timer.start();
+
+	for (Camera *camera : m_cameras)
+	{
+		m_pending_startups[camera->getId()] = std::async(std::launch::async, [this, camera, start] {
+			const CameraStartupReport report = bringUpCamera(camera, start);
+			QMetaObject::invokeMethod(this, [this, report] { onCameraStartupFinished(report); }, Qt::QueuedConnection);
+		});
+	}
+
+	if (m_pending_startups.empty())
+	{
+		emit startupFinished(m_startup_reports);
+	}
+}
+
+CameraStartupReport CamerasManager::bringUpCamera(Camera *camera, const bool start)
+{
+	using Clock = std::chrono::steady_clock;
+	const auto begin = Clock::now();
+	const auto elapsedMs = [begin](const Clock::time_point until) {
+		return std::chrono::duration<double, std::milli>(until - begin).count();
+	};
+
+	CameraStartupReport report;
+	report.camera_id = camera->getId();
+
+	report.connected = camera->connect();
+	report.connect_ms = elapsedMs(Clock::now());
+	if (!report.connected)
+	{
+		report.error = "Failed to connect";
+		return report;
+	}
+
+	if (!start)
+	{
+		return report;
+	}
+
+	// A packet of an earlier run may still be in the ring; read from the first one published after start()
+	const FrameRingBuffer &ring = camera->frameRing();
+	FrameRingBuffer::Cursor cursor = ring.cursorAtHead();
+
+	report.started = camera->start();
+	if (!report.started)
+	{
+		report.error = "Failed to start acquisition";
+		return report;
+	}
+
+	// The packet carries its own capture time, so polling granularity does not skew the result
+	const auto deadline = begin + std::chrono::milliseconds(kFirstFrameTimeoutMs);
+	while (Clock::now() < deadline)
+	{
+		FramePacketPtr packet;
+		if (ring.readNext(cursor, packet))
+		{
+			report.first_frame_ms = elapsedMs(Clock::time_point(std::chrono::nanoseconds(packet->timestamp_ns)));
+			return report;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+
+	report.error = QString("No frame within %1 ms").arg(kFirstFrameTimeoutMs);
+	return report;
+}
+
+void CamerasManager::onCameraStartupFinished(const CameraStartupReport &report)
+{
+	// Removed while starting up: removeCamera() already waited for the task
+	if (!m_cameras.contains(report.camera_id))
+	{
+		return;
+	}
+
+	if (const auto pending = m_pending_startups.find(report.camera_id); pending != m_pending_startups.end())
+	{
+		pending->second.wait();
+		m_pending_startups.erase(pending);
+	}
+
+	m_startup_reports.append(report);
+
+	QString timing = QString("connect %1 ms").arg(report.connect_ms, 0, 'f', 1);
+	if (report.first_frame_ms >= 0.0)
+	{
+		timing += QString(", first frame %1 ms").arg(report.first_frame_ms, 0, 'f', 1);
+	}
+
+	if (report.error.isEmpty())
+	{
+		addLog(LogLevel::Info, QString("Camera up (%1)").arg(timing), report.camera_id);
+	}
+	else
+	{
+		addLog(LogLevel::Error, QString("Camera startup failed: %1 (%2)").arg(report.error, timing), report.camera_id);
+	}
+	emit cameraStartupFinished(report);
+
+	if (m_pending_startups.empty())
+	{
+		finishStartup();
+	}
+}
+
+void CamerasManager::finishStartup()
+{
+	int failed = 0;
+	const CameraStartupReport *slowest = nullptr;
+	for (const auto &entry : m_startup_reports)
+	{
+		if (!entry.error.isEmpty())
+		{
+			++failed;
+		}
+		const double total = entry.first_frame_ms >= 0.0 ? entry.first_frame_ms : entry.connect_ms;
+		const double slowestTotal = slowest ? (slowest->first_frame_ms >= 0.0 ? slowest->first_frame_ms : slowest->connect_ms) : -1.0;
+		if (total > slowestTotal)
+		{
+			slowest = &entry;
+		}
+	}
+
+	addLog(failed == 0 ? LogLevel::Info : LogLevel::Warning,
+		QString("Startup of %1 cameras finished in %2 ms (%3 failed, slowest: camera %4)")
+			.arg(m_startup_reports.size())
+			.arg(m_startup_timer.elapsed())
+			.arg(failed)
+			.arg(slowest ? slowest->camera_id : -1));
+	emit startupFinished(m_startup_reports);
+}
+
+void CamerasManager::waitForStartup()
+{
+	for (auto &[cameraId, pending] : m_pending_startups)
+	{
+		pending.wait();
+	}
+}
+
 cv::Mat CamerasManager::getFrame(const int cameraId)
 {
 	Camera *camera = getCamera(cameraId);
@@ -173,20 +440,92 @@ QMap<int, cv::Mat> CamerasManager::getAllFrames()
 {
 	QMap<int, cv::Mat> frames;
 
-	for (auto it = m_cameras.begin(); it != m_cameras.end(); ++it)
+	const QMap<int, FramePacketPtr> packets = getDisplayPackets();
+	for (auto it = packets.cbegin(); it != packets.cend(); ++it)
 	{
-		int cameraId = it.key();
+		frames[it.key()] = it.value()->frame;
+	}
 
-		if (Camera *camera = it.value(); camera->isRunning())
+	return frames;
+}
+
+QMap<int, FramePacketPtr> CamerasManager::getDisplayPackets() const
+{
+	QMap<int, FramePacketPtr> packets;
+
+	for (auto it = m_display_packets.cbegin(); it != m_display_packets.cend(); ++it)
+	{
+		if (const Camera *camera = getCamera(it.key()); camera && camera->isRunning() && it.value())
 		{
-			if (cv::Mat frame = camera->getFrame(); !frame.empty())
-			{
-				frames[cameraId] = frame;
-			}
+			packets[it.key()] = it.value();
 		}
 	}
 
-	return frames;
+	return packets;
+}
+
+QMap<int, FramePacketPtr> CamerasManager::getLatestPackets() const
+{
+	QMap<int, FramePacketPtr> packets;
+
+	for (const Camera *camera : m_cameras)
+	{
+		FramePacketPtr packet;
+		if (camera->isRunning() && camera->frameRing().readLatest(packet) && packet)
+		{
+			packets[camera->getId()] = packet;
+		}
+	}
+
+	return packets;
+}
+
+int CamerasManager::addFrameConsumer(const QString &name, FrameDispatcher::Callback callback,
+	const BackpressurePolicy &policy, const AcquisitionSettings &variant)
+{
+	const int consumerId = m_dispatcher.addConsumer(name, std::move(callback), policy, variant);
+	addLog(LogLevel::Info, QString("Frame consumer '%1' registered").arg(name));
+	return consumerId;
+}
+
+void CamerasManager::removeFrameConsumer(const int consumerId)
+{
+	m_dispatcher.removeConsumer(consumerId);
+}
+
+void CamerasManager::setSyncGroup(const QVector<int> &cameraIds, const double toleranceMs)
+{
+	if (cameraIds.size() < 2)
+	{
+		clearSyncGroup();
+		return;
+	}
+
+	m_sync_tolerance_ms = toleranceMs;
+	m_synchronizer.configure(cameraIds, static_cast<int64_t>(toleranceMs * 1e6));
+
+	QStringList ids;
+	for (const int id : cameraIds)
+	{
+		ids << QString::number(id);
+	}
+	addLog(LogLevel::Info, QString("Sync group set to cameras %1 (tolerance %2 ms)").arg(ids.join(", ")).arg(toleranceMs));
+}
+
+void CamerasManager::clearSyncGroup()
+{
+	if (!m_synchronizer.isActive())
+	{
+		return;
+	}
+
+	const FrameSynchronizer::Statistics stats = m_synchronizer.statistics();
+	m_synchronizer.clear();
+	addLog(LogLevel::Info, QString("Sync group cleared after %1 sets (mean skew %2 ms, max skew %3 ms, %4 unmatched frames)")
+		.arg(stats.sets)
+		.arg(stats.mean_skew_ns / 1e6, 0, 'f', 2)
+		.arg(stats.max_skew_ns / 1e6, 0, 'f', 2)
+		.arg(stats.discarded));
 }
 
 CameraParameters CamerasManager::getCameraParameters(const int cameraId)
@@ -201,6 +540,19 @@ CameraParameters CamerasManager::getCameraParameters(const int cameraId)
 	return camera->getParameters();
 }
 
+FrameStatistics CamerasManager::getFrameStatistics(const int cameraId) const
+{
+	const Camera *camera = getCamera(cameraId);
+	if (!camera)
+	{
+		return {};
+	}
+
+	FrameStatistics statistics = camera->frameStatistics();
+	statistics.dispatch_dropped = m_dispatcher.droppedFrames(cameraId);
+	return statistics;
+}
+
 void CamerasManager::clearLogs()
 {
 	m_log_history.clear();
@@ -276,6 +628,51 @@ void CamerasManager::setGain(const int cameraId, const double value)
 	}
 }
 
+bool CamerasManager::setAcquisitionSettings(const int cameraId, const AcquisitionSettings &settings)
+{
+	Camera *camera = getCamera(cameraId);
+	if (!camera)
+	{
+		addLog(LogLevel::Warning, QString("Cannot set acquisition settings: Camera ID %1 not found").arg(cameraId));
+		return false;
+	}
+
+	// The recording keeps the frame size and rate it was opened with
+	if (m_videoSaver.isRecording() && settings != camera->acquisitionSettings())
+	{
+		addLog(LogLevel::Warning, "Acquisition settings cannot be changed while recording", cameraId);
+		return false;
+	}
+
+	if (!camera->setAcquisitionSettings(settings))
+	{
+		addLog(LogLevel::Warning,
+			QString("Invalid acquisition settings (ROI %1x%2+%3+%4, binning %5, decimation %6)")
+				.arg(settings.roi.width).arg(settings.roi.height).arg(settings.roi.x).arg(settings.roi.y)
+				.arg(settings.binning).arg(settings.decimation),
+			cameraId);
+		return false;
+	}
+
+	const QString roi = settings.roi.empty()
+		? QString("full frame")
+		: QString("%1x%2+%3+%4").arg(settings.roi.width).arg(settings.roi.height).arg(settings.roi.x).arg(settings.roi.y);
+	addLog(LogLevel::Info,
+		QString("Acquisition set to ROI %1, binning %2, every %3. frame").arg(roi).arg(settings.binning).arg(settings.decimation),
+		cameraId);
+	emit parametersUpdated(cameraId);
+	return true;
+}
+
+AcquisitionSettings CamerasManager::getAcquisitionSettings(const int cameraId) const
+{
+	if (const Camera *camera = getCamera(cameraId))
+	{
+		return camera->acquisitionSettings();
+	}
+	return {};
+}
+
 void CamerasManager::setPowerStatus(const int cameraId, const bool on)
 {
 	if (Camera *camera = getCamera(cameraId))
@@ -289,10 +686,11 @@ void CamerasManager::setPowerStatus(const int cameraId, const bool on)
 void CamerasManager::setAutoUpdate(const bool enabled, const int intervalMs)
 {
 	m_auto_update_enabled = enabled;
+	m_auto_update_interval_ms = std::max(intervalMs, 1);
 
 	if (enabled)
 	{
-		m_auto_update_timer->start(intervalMs);
+		m_auto_update_timer->start(m_auto_update_interval_ms);
 		addLog(LogLevel::Info, QString("Auto-update enabled (%1 ms interval)").arg(intervalMs));
 	}
 	else
@@ -317,26 +715,202 @@ void CamerasManager::onAutoUpdateTimer()
 {
 	if (m_auto_update_enabled)
 	{
+		dispatchFrames();
+		adaptDispatchInterval();
 		emit framesUpdated();
 
-		// Also emit parameter updates for monitoring
-		for (const int cameraId : getCameraIds())
+		// Also emit parameter updates for monitoring; the shared copy stays valid if a slot removes a camera
+		const QVector<int> cameraIds = getCameraIds();
+		for (const int cameraId : cameraIds)
 		{
 			emit parametersUpdated(cameraId);
+		}
+	}
+}
+
+FrameDispatcher::ConsumerStatistics CamerasManager::getRecordingStatistics() const
+{
+	return m_recording_consumer_id >= 0 ? m_dispatcher.consumerStatistics(m_recording_consumer_id)
+										: FrameDispatcher::ConsumerStatistics();
+}
 
-			if (m_videoSaver.isRecording())
+void CamerasManager::reconfigureVideoSaver()
+{
+	// Queued writes refer to the streams that are about to be replaced
+	if (m_recording_consumer_id >= 0)
+	{
+		m_dispatcher.flush(m_recording_consumer_id);
+	}
+	const QVector<int> &ids = m_cameras.handles();
+	m_videoSaver.configureCameras(QList<int>(ids.begin(), ids.end()));
+}
+
+void CamerasManager::setThreadPlacement(const ThreadPlacementConfig &config)
+{
+	m_placement = ThreadPlacement(config);
+	m_placed_cores.clear();
+	addLog(LogLevel::Info, m_placement.describe());
+	applyThreadPlacement();
+}
+
+bool CamerasManager::setRealtimeScheduling(const RealtimeSchedulingConfig &config)
+{
+	RealtimeSchedulingConfig effective = config;
+	QString error;
+	if (config.policy != RealtimeSchedulingConfig::Policy::Off && !RealtimeScheduling::probe(config, &error))
+	{
+		addLog(LogLevel::Warning, QString("Real-time scheduling (%1) unavailable, acquisition keeps normal priority: %2")
+			.arg(RealtimeScheduling::policyName(config.policy), error));
+		effective = RealtimeSchedulingConfig();
+	}
+
+	const bool switching = effective.policy != m_realtime.policy || effective.priority != m_realtime.priority ||
+		effective.lock_memory != m_realtime.lock_memory;
+	m_realtime = effective;
+	if (!switching)
+	{
+		return effective.policy == config.policy;
+	}
+
+	bool ok = true;
+	for (auto *camera : m_cameras)
+	{
+		ok = camera->setRealtimeScheduling(m_realtime) && ok;
+	}
+
+	if (m_realtime.policy == RealtimeSchedulingConfig::Policy::Off)
+	{
+		addLog(LogLevel::Info, "Acquisition threads use normal scheduling");
+		return config.policy == RealtimeSchedulingConfig::Policy::Off;
+	}
+
+	const long long lockLimit = RealtimeScheduling::memoryLockLimit();
+	addLog(ok ? LogLevel::Info : LogLevel::Warning,
+		QString("Acquisition threads use %1 priority %2%3%4")
+			.arg(RealtimeScheduling::policyName(m_realtime.policy))
+			.arg(m_realtime.priority)
+			.arg(m_realtime.lock_memory ? ", frame pools locked in RAM" : "")
+			.arg(m_realtime.lock_memory && lockLimit >= 0 ? QString(" (limit %1 KiB)").arg(lockLimit / 1024) : QString()));
+	return ok;
+}
+
+void CamerasManager::applyThreadPlacement()
+{
+	// Without a policy threads are released to every core, undoing an earlier placement
+	// Cameras keep their number while others are removed, so only a new camera changes placement
+	std::vector<QVector<int>> worker_cores(m_executor.workerCount());
+	for (const int cameraId : m_cameras.handles())
+	{
+		const int number = SlotMap<Camera *>::slotIndex(cameraId);
+		const QVector<int> cores = m_placement.coresFor(m_placement.isEnabled() ? number : -1);
+
+		// Encoding of a camera is queued on its preferred worker, which follows the camera's cores
+		QVector<int> &worker = worker_cores[m_executor.preferredWorker(cameraId)];
+		for (const int core : cores)
+		{
+			if (!worker.contains(core))
+			{
+				worker.append(core);
+			}
+		}
+
+		const bool pinned = getCamera(cameraId)->setCpuAffinity(cores);
+		if (m_placement.isEnabled() && m_placed_cores.value(cameraId) != cores)
+		{
+			m_placed_cores.insert(cameraId, cores);
+			// A core set spanning several nodes has no node of its own
+			int node = m_placement.numaNodeOf(cores.first());
+			for (const int core : cores)
 			{
-				m_videoSaver.onNewFrame(cameraId, getFrame(cameraId));
+				if (m_placement.numaNodeOf(core) != node)
+				{
+					node = -1;
+					break;
+				}
 			}
+			addLog(pinned ? LogLevel::Info : LogLevel::Warning,
+				QString("Camera %1 threads %2 cores %3%4")
+					.arg(cameraId)
+					.arg(pinned ? "on" : "could not be pinned to")
+					.arg(ThreadPlacement::formatCores(cores))
+					.arg(node >= 0 ? QString(" (NUMA node %1)").arg(node) : QString()),
+				cameraId);
+		}
+	}
+
+	// Workers serving no camera may run anywhere
+	for (std::size_t i = 0; i < worker_cores.size(); ++i)
+	{
+		const QVector<int> &cores = worker_cores[i].isEmpty() ? m_placement.availableCores() : worker_cores[i];
+		QString error;
+		if (!ThreadPlacement::pin(m_executor.nativeHandle(i), cores, &error) && m_placement.isEnabled())
+		{
+			addLog(LogLevel::Warning, QString("Cannot pin encoding worker %1: %2").arg(i).arg(error));
+		}
+	}
+}
+
+void CamerasManager::dispatchFrames()
+{
+	for (const Camera *camera : m_cameras)
+	{
+		m_dispatcher.dispatch(camera->getId(), camera->frameRing());
+	}
+
+	if (m_recording_consumer_id >= 0)
+	{
+		const bool backedUp = m_dispatcher.consumerStatistics(m_recording_consumer_id).backed_up;
+		if (backedUp != m_recording_backed_up)
+		{
+			m_recording_backed_up = backedUp;
+			addLog(backedUp ? LogLevel::Warning : LogLevel::Info,
+				backedUp ? "Recording falls behind, preview is reduced" : "Recording caught up");
 		}
 	}
 }
 
+void CamerasManager::adaptDispatchInterval()
+{
+	// Dispatch before a ring is half full, so recording keeps every frame even if an update is late
+	int intervalMs = m_auto_update_interval_ms;
+	for (const Camera *camera : m_cameras)
+	{
+		FramePacketPtr packet;
+		if (camera->frameRing().readLatest(packet) && packet && packet->fps > 0.0)
+		{
+			const double halfRingMs = 1000.0 * (camera->frameRing().capacity() / 2) / packet->fps;
+			intervalMs = std::min(intervalMs, std::max(1, static_cast<int>(halfRingMs)));
+		}
+	}
+
+	// Shorten at once, lengthen only by more than a quarter or back to the configured interval:
+	// the measured rates jitter. Routine retuning goes to the debug output, not the session log.
+	const int current = m_auto_update_timer->interval();
+	if (intervalMs < current || intervalMs > current + std::max(2, current / 4) ||
+		(intervalMs == m_auto_update_interval_ms && intervalMs != current))
+	{
+		m_auto_update_timer->setInterval(intervalMs);
+		qDebug() << "[CamerasManager] frame dispatch interval" << current << "->" << intervalMs << "ms";
+	}
+}
+
 void CamerasManager::startRecording(QString directory, VideoFormat format)
 {
 	if (!m_videoSaver.isRecording())
 	{
 		m_videoSaver.startRecording(directory, m_interval_ms, format);
+
+		// Encoding runs off the GUI thread; a disk that cannot keep up loses frames instead of stalling the UI
+		BackpressurePolicy policy;
+		policy.mode = BackpressurePolicy::Mode::Bounded;
+		policy.capacity = kRecordingQueueCapacity;
+		policy.high_water = kRecordingQueueHighWater;
+		policy.stage = WorkStealingPool::Stage::Encoding;
+		m_recording_consumer_id = m_dispatcher.addConsumer(
+			"VideoSaver", [this](const FramePacketPtr &packet) {
+				m_videoSaver.onNewFrame(packet);
+			}, policy);
+		m_recording_backed_up = false;
 	}
 }
 
@@ -344,7 +918,19 @@ void CamerasManager::stopRecording()
 {
 	if (m_videoSaver.isRecording())
 	{
+		dispatchFrames();
+		m_dispatcher.flush(m_recording_consumer_id);
+		const FrameDispatcher::ConsumerStatistics stats = m_dispatcher.consumerStatistics(m_recording_consumer_id);
+		m_dispatcher.removeConsumer(m_recording_consumer_id);
+		m_recording_consumer_id = -1;
+		m_recording_backed_up = false;
 		m_videoSaver.stopRecording();
+
+		addLog(stats.dropped == 0 ? LogLevel::Info : LogLevel::Warning,
+			QString("Recording stopped: %1 frames written, %2 dropped by backpressure, max queue depth %3")
+				.arg(stats.delivered)
+				.arg(stats.dropped)
+				.arg(stats.max_queue_depth));
 	}
 }
 void CamerasManager::addLog(const LogLevel level, const QString &message, const int cameraId)
@@ -413,7 +999,9 @@ void CamerasManager::startParameterLogging( const QString& directory, int interv
 
 	// Write CSV header with camera_id column
 	QTextStream out( m_param_file );
-	out << "timestamp,camera_id,camera_name,fps,temperature" << Qt::endl;
+	out << "timestamp,camera_id,camera_name,fps,temperature,frame_counter,"
+		   "frames_dropped,frames_duplicated,frame_gaps,dispatch_dropped"
+		<< Qt::endl;
 	out.flush();
 
 	// Start the timer
@@ -468,10 +1056,33 @@ void CamerasManager::writeParametersToFile()
 
 	for ( const auto& cameraId : getCameraIds() )
 	{
-		const CameraParameters params = getCameraParameters( cameraId );
 		const QString cameraName = QString( "Camera %1" ).arg( cameraId );
 
-		out << timestamp << "," << cameraId << "," << cameraName << "," << params.fps << "," << params.temperature << Qt::endl;
+		// Prefer the metadata captured with the latest frame over the sampled parameters,
+		// but only while the camera runs: a stopped camera's last packet is stale
+		double fps = 0.0;
+		double temperature = 0.0;
+		uint64_t frameCounter = 0;
+		const Camera* camera = getCamera( cameraId );
+		const FramePacketPtr packet = camera && camera->isRunning() ? m_display_packets.value( cameraId ) : nullptr;
+		if ( packet )
+		{
+			fps = packet->fps;
+			temperature = packet->temperature;
+			frameCounter = packet->frame_counter;
+		}
+		else
+		{
+			const CameraParameters params = getCameraParameters( cameraId );
+			fps = params.fps;
+			temperature = params.temperature;
+			frameCounter = params.frame_counter;
+		}
+
+		const FrameStatistics frames = getFrameStatistics( cameraId );
+		out << timestamp << "," << cameraId << "," << cameraName << "," << fps << "," << temperature << ","
+			<< frameCounter << "," << frames.dropped << "," << frames.duplicated << "," << frames.gaps << ","
+			<< frames.dispatch_dropped << Qt::endl;
 	}
 
 	m_param_file->flush();
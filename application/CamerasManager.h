@@ -2,7 +2,18 @@
 #define CAMERASMANAGER_H
 
 #include "Camera.h"
+#include "CameraWatchdog.h"
+#include "CameraStartupReport.h"
+#include "FrameDispatcher.h"
+#include "FrameSynchronizer.h"
 #include "LogEntry.h"
+#include "RealtimeScheduling.h"
+#include "ReplayCameraConfig.h"
+#include "SlotMap.h"
+#include "SyntheticCameraConfig.h"
+#include "TelemetrySampler.h"
+#include "ThreadPlacement.h"
+#include "WorkStealingPool.h"
 #include "videosaver.h"
 #include <QObject>
 #include <QVector>
@@ -13,6 +24,9 @@
 #include <QTextStream>
 #include <opencv2/opencv.hpp>
 #include <QFileDialog>
+#include <QElapsedTimer>
+#include <future>
+#include <map>
 
 /**
  * @class CamerasManager
@@ -39,9 +53,28 @@ public:
 
 	/**
 	 * @brief Add a new camera to the manager
+	 * @param backend Source of frames and parameters, nullptr for CameraBackend::createDefault()
 	 * @return The ID of the newly added camera
 	 */
-	int addCamera();
+	int addCamera(std::unique_ptr<CameraBackend> backend = nullptr);
+
+	/**
+	 * @brief Add cameras running on the synthetic backend, e.g. for load testing
+	 * @param count Number of cameras to add
+	 * @param config Settings shared by all of them; a non-zero seed is offset per camera
+	 * @return The IDs of the newly added cameras
+	 */
+	QVector<int> addSyntheticCameras(int count, const SyntheticCameraConfig &config = SyntheticCameraConfig());
+
+	/**
+	 * @brief Add a camera replaying a recorded video file or raw frame dump
+	 *
+	 * The recording is decoded into memory when the camera connects.
+	 *
+	 * @param config Source and replay timing
+	 * @return The ID of the newly added camera
+	 */
+	int addReplayCamera(const ReplayCameraConfig &config);
 
 	/**
 	 * @brief Remove a camera by ID
@@ -68,9 +101,16 @@ public:
 
 	/**
 	 * @brief Get all camera IDs
+	 *
+	 * In the order the cameras were added. The list is kept by the registry,
+	 * so a copy is free until a camera is added or removed.
+	 *
 	 * @return List of all camera IDs
 	 */
-	QVector<int> getCameraIds() const;
+	const QVector<int> &getCameraIds() const
+	{
+		return m_cameras.handles();
+	}
 
 	/**
 	 * @brief Connect all cameras
@@ -95,25 +135,207 @@ public:
 	void stopAll();
 
 	/**
-	 * @brief Get the latest frame from a specific camera
+	 * @brief Connect all cameras concurrently without blocking the caller
+	 *
+	 * Each camera reports through cameraStartupFinished() as soon as it is
+	 * done; startupFinished() follows once all cameras reported.
+	 */
+	void connectAllAsync();
+
+	/**
+	 * @brief Connect and start all cameras concurrently without blocking the caller
+	 *
+	 * Like connectAllAsync(), additionally starts acquisition and measures the
+	 * time until each camera delivered its first frame.
+	 */
+	void startAllAsync();
+
+	/**
+	 * @brief Check whether an asynchronous bring-up is still running
+	 */
+	bool isStartupInProgress() const
+	{
+		return !m_pending_startups.empty();
+	}
+
+	/**
+	 * @brief Get the latest frame published by a specific camera
 	 * @param cameraId Camera ID
 	 * @return OpenCV Mat with the frame
 	 */
 	cv::Mat getFrame(int cameraId);
 
 	/**
-	 * @brief Get frames from all cameras
+	 * @brief Get the frames handed to the display in the last dispatch
+	 *
+	 * These are the same (shared, not copied) cv::Mat instances that were
+	 * passed to every other consumer, e.g. the VideoSaver.
+	 *
 	 * @return Map of camera ID to frame
 	 */
 	QMap<int, cv::Mat> getAllFrames();
 
 	/**
-	 * @brief Get parameters for a specific camera
+	 * @brief Get the packets handed to the display in the last dispatch
+	 * @return Map of camera ID to frame packet (running cameras only)
+	 */
+	QMap<int, FramePacketPtr> getDisplayPackets() const;
+
+	/**
+	 * @brief Get the newest packet of every running camera, straight from its frame ring
+	 *
+	 * Unlike getDisplayPackets() this does not wait for the next dispatch, so
+	 * a display clock running independently of dispatch always shows the most
+	 * recent frame.
+	 *
+	 * @return Map of camera ID to frame packet
+	 */
+	QMap<int, FramePacketPtr> getLatestPackets() const;
+
+	/**
+	 * @brief Register an additional frame consumer
+	 * @param name Name used in logs
+	 * @param callback Callback receiving every frame of every camera
+	 * @param policy Handling of frames the consumer cannot keep up with
+	 * @param variant Region of interest, binning and decimation of the frames this
+	 *        consumer receives; the other consumers keep the full frames
+	 * @return Handle for removeFrameConsumer()
+	 */
+	int addFrameConsumer(const QString &name, FrameDispatcher::Callback callback,
+		const BackpressurePolicy &policy = BackpressurePolicy(),
+		const AcquisitionSettings &variant = AcquisitionSettings());
+
+	/**
+	 * @brief Get the delivery counters of a frame consumer
+	 * @param consumerId Handle returned by addFrameConsumer()
+	 */
+	FrameDispatcher::ConsumerStatistics getFrameConsumerStatistics(int consumerId) const
+	{
+		return m_dispatcher.consumerStatistics(consumerId);
+	}
+
+	/**
+	 * @brief Get the delivery counters of the recording, zero when not recording
+	 */
+	FrameDispatcher::ConsumerStatistics getRecordingStatistics() const;
+
+	/**
+	 * @brief Check whether the recording queue reached its high-water mark
+	 *
+	 * The preview should back off while this is true, so encoding gets the CPU.
+	 */
+	bool isRecordingBackedUp() const
+	{
+		return m_recording_backed_up;
+	}
+
+	/**
+	 * @brief Unregister a frame consumer
+	 * @param consumerId Handle returned by addFrameConsumer()
+	 */
+	void removeFrameConsumer(int consumerId);
+
+	/**
+	 * @brief Group cameras whose frames are delivered as timestamp-aligned FrameSets
+	 * @param cameraIds Cameras of the group (at least two)
+	 * @param toleranceMs Maximum capture time spread within one set in ms
+	 */
+	void setSyncGroup(const QVector<int> &cameraIds, double toleranceMs = 5.0);
+
+	/**
+	 * @brief Stop building FrameSets
+	 */
+	void clearSyncGroup();
+
+	/**
+	 * @brief Get matching counters and the measured inter-camera skew of the sync group
+	 */
+	const FrameSynchronizer::Statistics &getSyncStatistics() const
+	{
+		return m_synchronizer.statistics();
+	}
+
+	/**
+	 * @brief Shared work-stealing executor for per-camera processing stages
+	 * @return Executor used for encoding and preview rendering
+	 */
+	WorkStealingPool &executor()
+	{
+		return m_executor;
+	}
+
+	/**
+	 * @brief Get the cached parameters of a specific camera
+	 *
+	 * Returns the snapshot of the last telemetry sample; never blocks on the camera.
+	 *
 	 * @param cameraId Camera ID
 	 * @return CameraParameters struct
 	 */
 	CameraParameters getCameraParameters(int cameraId);
 
+	/**
+	 * @brief Get the frame delivery counters of a specific camera
+	 * @param cameraId Camera ID
+	 * @return Dropped, duplicated and gap counts of the camera plus frames lost before dispatch
+	 */
+	FrameStatistics getFrameStatistics(int cameraId) const;
+
+	/**
+	 * @brief Set how often the parameters of all cameras are sampled
+	 * @param periodMs Sampling period in ms
+	 */
+	void setTelemetryPeriod(int periodMs)
+	{
+		m_telemetry.setPeriod(periodMs);
+	}
+
+	/**
+	 * @brief Get the parameter sampling period in ms
+	 */
+	int getTelemetryPeriod() const
+	{
+		return m_telemetry.period();
+	}
+
+	/**
+	 * @brief Set which cores the acquisition thread and encoding worker of each camera run on
+	 *
+	 * Applied to running threads right away and to every camera added later;
+	 * the resulting placement is logged.
+	 *
+	 * @param config Placement policy, e.g. from ThreadPlacement::loadConfig()
+	 */
+	void setThreadPlacement(const ThreadPlacementConfig &config);
+
+	/**
+	 * @brief Switch the acquisition threads to real-time scheduling (opt-in)
+	 *
+	 * Checks first whether the process may use the requested policy; if not,
+	 * a warning is logged and the threads keep normal scheduling. Applies to
+	 * running and future cameras.
+	 *
+	 * @param config Real-time mode, e.g. from RealtimeScheduling::loadConfig()
+	 * @return true if the mode is in effect
+	 */
+	bool setRealtimeScheduling(const RealtimeSchedulingConfig &config);
+
+	/**
+	 * @brief Get the real-time mode in effect (Policy::Off after a fallback)
+	 */
+	const RealtimeSchedulingConfig &getRealtimeScheduling() const
+	{
+		return m_realtime;
+	}
+
+	/**
+	 * @brief Get the current thread placement
+	 */
+	const ThreadPlacement &getThreadPlacement() const
+	{
+		return m_placement;
+	}
+
 	/**
 	 * @brief Get the log history
 	 * @return Vector of all log entries
@@ -160,6 +382,27 @@ public:
 	 */
 	void setGain(int cameraId, double value);
 
+	/**
+	 * @brief Set region of interest, binning and decimation of a camera
+	 *
+	 * Reduces the frames at the source, for every consumer. Use the variant of
+	 * addFrameConsumer() to reduce them for a single consumer only.
+	 *
+	 * @param cameraId Camera ID
+	 * @param settings New acquisition settings
+	 * Refused while recording, as the videos keep the frame size and rate they
+	 * were opened with, and for a region of interest outside the frame.
+	 *
+	 * @return false if the camera is unknown, the settings are invalid or a recording runs
+	 */
+	bool setAcquisitionSettings(int cameraId, const AcquisitionSettings &settings);
+
+	/**
+	 * @brief Get the acquisition settings of a camera, defaults if it is unknown
+	 * @param cameraId Camera ID
+	 */
+	AcquisitionSettings getAcquisitionSettings(int cameraId) const;
+
 	/**
 	 * @brief Set power status for a specific camera
 	 * @param cameraId Camera ID
@@ -169,8 +412,15 @@ public:
 
 	/**
 	 * @brief Enable/disable automatic frame updates
+	 *
+	 * Each update dispatches the new frames to the consumers (recording,
+	 * synchronizer, ...) and emits framesUpdated(). The interval is shortened
+	 * automatically while a camera runs so fast that its frame ring would
+	 * overflow between two updates. The display does not depend on it, it has
+	 * its own clock.
+	 *
 	 * @param enabled true to enable
-	 * @param intervalMs Update interval in milliseconds
+	 * @param intervalMs Longest update interval in milliseconds
 	 */
 	void setAutoUpdate(bool enabled, int intervalMs = 33); // ~30 FPS default
 
@@ -196,6 +446,30 @@ signals:
 	 */
 	void framesUpdated();
 
+	/**
+	 * @brief Forwarded from the acquisition thread of each camera
+	 * @param packet The acquired frame and its metadata
+	 */
+	void frameAcquired(const FramePacketPtr &packet);
+
+	/**
+	 * @brief Emitted for every timestamp-aligned set of the sync group
+	 * @param set Matching frames and their measured skew
+	 */
+	void frameSetReady(const FrameSet &set);
+
+	/**
+	 * @brief Emitted for each camera as soon as its asynchronous bring-up finished
+	 * @param report Result and timing of the camera
+	 */
+	void cameraStartupFinished(const CameraStartupReport &report);
+
+	/**
+	 * @brief Emitted once every camera of an asynchronous bring-up reported
+	 * @param reports Reports of all cameras in order of arrival
+	 */
+	void startupFinished(const QVector<CameraStartupReport> &reports);
+
 	/**
 	 * @brief Emitted when a new log entry is added
 	 * @param entry The log entry
@@ -229,6 +503,11 @@ private slots:
 	 */
 	void onParameterLogTimer();
 
+	/**
+	 * @brief Collect the report of one camera of an asynchronous bring-up
+	 */
+	void onCameraStartupFinished(const CameraStartupReport &report);
+
 private:
 	/**
 	 * @brief Add a log entry
@@ -247,13 +526,74 @@ private:
 
 	void createParameterLogFile(int cameraId);
 
-	QMap<int, Camera*> m_cameras;	///< Map of camera ID to Camera objects
-	int m_next_camera_id;			///< Next available camera ID
-    int m_interval_ms = 33;          ///< Interval for frame updates
+	/**
+	 * @brief Read each newly acquired frame once and hand it to all consumers
+	 */
+	void dispatchFrames();
+
+	/**
+	 * @brief Shorten the auto-update interval so no frame ring overflows between two updates
+	 */
+	void adaptDispatchInterval();
+
+	/**
+	 * @brief Hand the current camera list to the VideoSaver once no write is pending
+	 */
+	void reconfigureVideoSaver();
+
+	/**
+	 * @brief Pin acquisition threads and encoding workers according to m_placement
+	 */
+	void applyThreadPlacement();
+
+	static constexpr std::size_t kRecordingQueueCapacity = 32; ///< Frames queued per camera for encoding
+	static constexpr std::size_t kRecordingQueueHighWater = 16; ///< Queue depth that reduces the preview
+
+	/**
+	 * @brief Launch one bring-up task per camera
+	 * @param start true to start acquisition after connecting
+	 */
+	void bringUpAllAsync(bool start);
+
+	/**
+	 * @brief Connect (and start) one camera and measure it; runs on a helper thread
+	 */
+	static CameraStartupReport bringUpCamera(Camera *camera, bool start);
+
+	/**
+	 * @brief Block until all asynchronous bring-up tasks returned
+	 */
+	void waitForStartup();
+
+	/**
+	 * @brief Log the summary of a finished bring-up and emit startupFinished()
+	 */
+	void finishStartup();
+
+	static constexpr int kFirstFrameTimeoutMs = 5000; ///< Wait for the first frame after start
+
+	SlotMap<Camera*> m_cameras;		///< Cameras by ID; a removed camera's ID never resolves again
+    int m_interval_ms = 33;          ///< Interval for frame updates, fallback recording frame rate
 	QVector<LogEntry> m_log_history; ///< Log history
 	QTimer* m_auto_update_timer;		///< Timer for automatic frame updates
 	bool m_auto_update_enabled;		///< Auto-update enabled flag
+	int m_auto_update_interval_ms = 33;	///< Configured (longest) auto-update interval
+	WorkStealingPool m_executor;     ///< Shared executor, must outlive m_videoSaver
+	TelemetrySampler m_telemetry;    ///< Samples camera parameters in the background
+	CameraWatchdog m_watchdog;       ///< Reconnects failed or stalled cameras
+	ThreadPlacement m_placement;     ///< Core assignment of the per-camera threads
+	QMap<int, QVector<int>> m_placed_cores; ///< Cores each camera was last pinned to, for logging changes
+	RealtimeSchedulingConfig m_realtime;    ///< Scheduling of the acquisition threads in effect
     VideoSaver m_videoSaver;        ///< Writer for saving files
+	FrameDispatcher m_dispatcher;        ///< Fans each frame out to all consumers
+	QMap<int, FramePacketPtr> m_display_packets; ///< Latest dispatched packet per camera for the display
+	int m_recording_consumer_id = -1;    ///< Dispatcher handle of the VideoSaver while recording
+	bool m_recording_backed_up = false;  ///< Recording queue is above its high-water mark
+	FrameSynchronizer m_synchronizer;    ///< Builds FrameSets of the sync group
+	double m_sync_tolerance_ms = 5.0;    ///< Tolerance of the sync group in ms
+	std::map<int, std::future<void>> m_pending_startups; ///< Running bring-up task per camera
+	QVector<CameraStartupReport> m_startup_reports;       ///< Reports of the running bring-up
+	QElapsedTimer m_startup_timer;                         ///< Wall time of the running bring-up
 	QFile m_log_file;                 ///< File handle for persisting logs
 	QString m_log_directory;          ///< Selected directory for log file
 	QTimer* m_parameter_log_timer;    ///< Timer for parameter logging
@@ -0,0 +1,297 @@
+#include "FrameDispatcher.h"
+#include "FrameReduction.h"
+#include <QDebug>
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+FrameDispatcher::~FrameDispatcher()
+{
+	// Queued callbacks may refer to objects destroyed right after the dispatcher
+	while ( !m_consumers.isEmpty() )
+	{
+		removeConsumer( m_consumers.last().id );
+	}
+}
+
+FrameDispatcher::ConsumerState::~ConsumerState()
+{
+	for ( auto& [cameraId, lane] : lanes )
+	{
+		if ( lane.pool )
+		{
+			lane.pool->retire();
+		}
+	}
+}
+
+int FrameDispatcher::addConsumer( const QString& name, Callback callback, const BackpressurePolicy& policy,
+								  const AcquisitionSettings& variant )
+{
+	auto state = std::make_shared<ConsumerState>();
+	state->name = name;
+	state->callback = std::move( callback );
+	state->policy = policy;
+	state->variant = variant;
+	state->variant.binning = std::max( variant.binning, 1 );
+	state->variant.decimation = std::max( variant.decimation, 1 );
+	state->policy.capacity = std::max<std::size_t>( policy.capacity, 1 );
+	state->policy.high_water = std::clamp<std::size_t>( policy.high_water, 1, state->policy.capacity );
+
+	const int consumerId = m_next_consumer_id++;
+	m_consumers.append( Consumer { consumerId, std::move( state ) } );
+	return consumerId;
+}
+
+bool FrameDispatcher::removeConsumer( const int consumerId, const bool flush )
+{
+	for ( int i = 0; i < m_consumers.size(); ++i )
+	{
+		if ( m_consumers[i].id == consumerId )
+		{
+			const std::shared_ptr<ConsumerState> state = m_consumers[i].state;
+			m_consumers.remove( i );
+
+			if ( !flush )
+			{
+				std::lock_guard<std::mutex> lock( state->mutex );
+				for ( auto& [cameraId, lane] : state->lanes )
+				{
+					lane.dropped += lane.queue.size();
+					lane.queue.clear();
+				}
+			}
+			waitIdle( *state );
+			return true;
+		}
+	}
+	return false;
+}
+
+void FrameDispatcher::flush( const int consumerId )
+{
+	if ( const std::shared_ptr<ConsumerState> state = stateOf( consumerId ) )
+	{
+		waitIdle( *state );
+	}
+}
+
+int FrameDispatcher::dispatch( const int cameraId, const FrameRingBuffer& ring )
+{
+	if ( !m_cursors.contains( cameraId ) )
+	{
+		m_cursors.insert( cameraId, ring.cursorAtHead() );
+	}
+
+	FrameRingBuffer::Cursor& cursor = m_cursors[cameraId];
+	FramePacketPtr packet;
+	int dispatched = 0;
+
+	while ( ring.readNext( cursor, packet ) )
+	{
+		for ( const Consumer& consumer : m_consumers )
+		{
+			deliver( consumer.state, packet );
+		}
+		++dispatched;
+	}
+
+	return dispatched;
+}
+
+void FrameDispatcher::removeCamera( const int cameraId )
+{
+	m_cursors.remove( cameraId );
+}
+
+FrameDispatcher::ConsumerStatistics FrameDispatcher::consumerStatistics( const int consumerId ) const
+{
+	ConsumerStatistics statistics;
+	const std::shared_ptr<ConsumerState> state = stateOf( consumerId );
+	if ( !state )
+	{
+		return statistics;
+	}
+
+	std::lock_guard<std::mutex> lock( state->mutex );
+	for ( const auto& [cameraId, lane] : state->lanes )
+	{
+		statistics.delivered += lane.delivered;
+		statistics.dropped += lane.dropped;
+		statistics.high_water_events += lane.high_water_events;
+		statistics.queue_depth += lane.queue.size();
+		statistics.max_queue_depth = std::max( statistics.max_queue_depth, lane.max_depth );
+		statistics.backed_up = statistics.backed_up || lane.backed_up;
+	}
+	return statistics;
+}
+
+void FrameDispatcher::deliver( const std::shared_ptr<ConsumerState>& state, const FramePacketPtr& packet )
+{
+	const BackpressurePolicy& policy = state->policy;
+	const int cameraId = packet->camera_id;
+
+	if ( state->variant.decimation > 1 )
+	{
+		std::lock_guard<std::mutex> lock( state->mutex );
+		if ( state->lanes[cameraId].decimation_phase++ % static_cast<uint64_t>( state->variant.decimation ) != 0 )
+		{
+			return;
+		}
+	}
+
+	if ( policy.mode == BackpressurePolicy::Mode::Inline || !m_executor )
+	{
+		// Like a queued delivery, a failing consumer must not abort the dispatch to the others
+		try
+		{
+			state->callback( variantOf( *state, packet ) );
+		}
+		catch ( const std::exception& e )
+		{
+			qWarning() << "[FrameDispatcher] consumer" << state->name << "failed:" << e.what();
+		}
+		std::lock_guard<std::mutex> lock( state->mutex );
+		++state->lanes[cameraId].delivered;
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock( state->mutex );
+	Lane& lane = state->lanes[cameraId];
+
+	switch ( policy.mode )
+	{
+	case BackpressurePolicy::Mode::Block:
+		state->changed.wait( lock, [&lane, &policy] { return lane.queue.size() < policy.capacity; } );
+		break;
+	case BackpressurePolicy::Mode::DropOldest:
+		while ( lane.queue.size() >= policy.capacity )
+		{
+			lane.queue.pop_front();
+			++lane.dropped;
+		}
+		break;
+	case BackpressurePolicy::Mode::LatestOnly:
+		lane.dropped += lane.queue.size();
+		lane.queue.clear();
+		break;
+	case BackpressurePolicy::Mode::Bounded:
+		if ( lane.queue.size() >= policy.capacity )
+		{
+			++lane.dropped;
+			return;
+		}
+		break;
+	case BackpressurePolicy::Mode::Inline:
+		break;
+	}
+
+	lane.queue.push_back( packet );
+	lane.max_depth = std::max( lane.max_depth, lane.queue.size() );
+	if ( !lane.backed_up && lane.queue.size() >= policy.high_water )
+	{
+		lane.backed_up = true;
+		++lane.high_water_events;
+	}
+
+	if ( !lane.draining )
+	{
+		lane.draining = true;
+		lock.unlock();
+		scheduleDrain( m_executor, state, cameraId );
+	}
+}
+
+FramePacketPtr FrameDispatcher::variantOf( ConsumerState& state, const FramePacketPtr& packet )
+{
+	if ( !state.variant.reducesPixels() )
+	{
+		// Decimation only: same pixels, lower stream rate
+		return FrameReduction::apply( packet, state.variant, nullptr );
+	}
+
+	// Per camera pool: frame sizes differ between cameras, and a pool keeps buffers of one size
+	FramePool* pool = nullptr;
+	{
+		std::lock_guard<std::mutex> lock( state.mutex );
+		Lane& lane = state.lanes[packet->camera_id];
+		if ( !lane.pool )
+		{
+			lane.pool = FramePool::create();
+		}
+		pool = lane.pool;
+	}
+	return FrameReduction::apply( packet, state.variant, pool );
+}
+
+void FrameDispatcher::scheduleDrain( WorkStealingPool* executor, const std::shared_ptr<ConsumerState>& state,
+									 const int cameraId )
+{
+	// One frame per task, so a busy consumer shares its worker with other strands between frames
+	executor->submit( state->policy.stage, cameraId, [executor, state, cameraId] {
+		FramePacketPtr packet;
+		{
+			std::lock_guard<std::mutex> lock( state->mutex );
+			Lane& lane = state->lanes[cameraId];
+			if ( lane.queue.empty() )
+			{
+				lane.draining = false;
+				state->changed.notify_all();
+				return;
+			}
+			packet = std::move( lane.queue.front() );
+			lane.queue.pop_front();
+		}
+		state->changed.notify_all();
+
+		try
+		{
+			state->callback( variantOf( *state, packet ) );
+		}
+		catch ( const std::exception& e )
+		{
+			qWarning() << "[FrameDispatcher] consumer" << state->name << "failed:" << e.what();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock( state->mutex );
+			Lane& lane = state->lanes[cameraId];
+			++lane.delivered;
+
+			// Hysteresis: only report recovery once the queue has drained to half the mark
+			if ( lane.backed_up && lane.queue.size() <= state->policy.high_water / 2 )
+			{
+				lane.backed_up = false;
+			}
+
+			if ( lane.queue.empty() )
+			{
+				lane.draining = false;
+				state->changed.notify_all();
+				return;
+			}
+		}
+		scheduleDrain( executor, state, cameraId );
+	} );
+}
+
+void FrameDispatcher::waitIdle( ConsumerState& state )
+{
+	std::unique_lock<std::mutex> lock( state.mutex );
+	state.changed.wait( lock, [&state] {
+		return std::none_of( state.lanes.begin(), state.lanes.end(),
+							 []( const auto& entry ) { return entry.second.draining; } );
+	} );
+}
+
+std::shared_ptr<FrameDispatcher::ConsumerState> FrameDispatcher::stateOf( const int consumerId ) const
+{
+	for ( const Consumer& consumer : m_consumers )
+	{
+		if ( consumer.id == consumerId )
+		{
+			return consumer.state;
+		}
+	}
+	return nullptr;
+}
@@ -0,0 +1,239 @@
+#ifndef FRAMEDISPATCHER_H
+#define FRAMEDISPATCHER_H
+
+#include "AcquisitionSettings.h"
+#include "FramePool.h"
+#include "FrameRingBuffer.h"
+#include "WorkStealingPool.h"
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+/**
+ * @struct BackpressurePolicy
+ * @brief What a consumer does with frames arriving faster than it processes them
+ *
+ * Every policy except Inline gives the consumer its own queue per camera,
+ * drained on the executor, so a slow consumer never delays the dispatching
+ * thread or the other consumers (unless it asked for Block).
+ */
+struct BackpressurePolicy
+{
+	/**
+	 * @enum Mode
+	 * @brief Handling of a full queue
+	 */
+	enum class Mode
+	{
+		Inline,		 ///< No queue, the callback runs on the dispatching thread
+		Block,		 ///< The dispatching thread waits until the queue has room
+		DropOldest,	 ///< The oldest queued frame is discarded to make room
+		LatestOnly,	 ///< Only the newest frame is kept, a queued one is replaced
+		Bounded		 ///< New frames are discarded while full; depth above high_water is reported
+	};
+
+	Mode mode = Mode::Inline;	 ///< Queue handling
+	std::size_t capacity = 8;	 ///< Frames queued per camera (Block, DropOldest, Bounded)
+	std::size_t high_water = 6;	 ///< Depth at which a queue counts as backed up
+
+	/// Executor stage running the callback of a queued consumer
+	WorkStealingPool::Stage stage = WorkStealingPool::Stage::Analytics;
+};
+
+/**
+ * @class FrameDispatcher
+ * @brief Fans every acquired frame out to all registered consumers
+ *
+ * The dispatcher reads each new FramePacket of a camera exactly once from
+ * the camera's FrameRingBuffer and hands the same packet handle to every
+ * consumer (display, VideoSaver, ...). No pixel data is copied, and all
+ * consumers of one dispatch see the identical frame and metadata.
+ *
+ * Each consumer declares a BackpressurePolicy when it subscribes. Queued
+ * consumers are called on the executor, one frame at a time and in capture
+ * order per camera.
+ *
+ * A consumer may also ask for its own variant of the frames (region of
+ * interest, binning, decimation). Decimation is applied before queueing;
+ * the pixel reduction runs where the callback runs, so it never delays the
+ * dispatching thread of a queued consumer. Other consumers keep the full
+ * frames.
+ */
+class FrameDispatcher
+{
+public:
+	/**
+	 * @brief Consumer callback, invoked once per frame and camera
+	 */
+	using Callback = std::function<void( const FramePacketPtr& packet )>;
+
+	/**
+	 * @struct ConsumerStatistics
+	 * @brief Delivery counters of one consumer, summed over all cameras
+	 */
+	struct ConsumerStatistics
+	{
+		uint64_t delivered = 0;			 ///< Frames handed to the callback
+		uint64_t dropped = 0;			 ///< Frames discarded by the policy
+		uint64_t high_water_events = 0;	 ///< Times a queue grew past the high-water mark
+		std::size_t queue_depth = 0;	 ///< Frames queued right now
+		std::size_t max_queue_depth = 0; ///< Deepest queue seen
+		bool backed_up = false;			 ///< A queue reached the high-water mark and has not drained yet
+	};
+
+	/**
+	 * @brief Destructor, waits for queued frames to be consumed
+	 */
+	~FrameDispatcher();
+
+	/**
+	 * @brief Set the executor running queued consumers
+	 * @param executor Executor, nullptr to run every consumer inline
+	 */
+	void setExecutor( WorkStealingPool* executor )
+	{
+		m_executor = executor;
+	}
+
+	/**
+	 * @brief Register a consumer
+	 * @param name Name used in logs
+	 * @param callback Callback receiving every dispatched frame
+	 * @param policy Handling of frames the consumer cannot keep up with
+	 * @param variant Reduction of the frames this consumer receives
+	 * @return Handle for removeConsumer()
+	 */
+	int addConsumer( const QString& name, Callback callback, const BackpressurePolicy& policy = BackpressurePolicy(),
+					 const AcquisitionSettings& variant = AcquisitionSettings() );
+
+	/**
+	 * @brief Unregister a consumer; returns once its callback is no longer running
+	 * @param consumerId Handle returned by addConsumer()
+	 * @param flush true to consume the queued frames first, false to discard them
+	 * @return true if the consumer was registered
+	 */
+	bool removeConsumer( int consumerId, bool flush = true );
+
+	/**
+	 * @brief Block until all frames queued for a consumer have been consumed
+	 * @param consumerId Handle returned by addConsumer()
+	 */
+	void flush( int consumerId );
+
+	/**
+	 * @brief Deliver all frames published since the last dispatch of this camera
+	 * @param cameraId Camera ID
+	 * @param ring Frame ring of the camera
+	 * @return Number of frames dispatched
+	 */
+	int dispatch( int cameraId, const FrameRingBuffer& ring );
+
+	/**
+	 * @brief Forget the read position of a camera (e.g. after removal)
+	 * @param cameraId Camera ID
+	 */
+	void removeCamera( int cameraId );
+
+	/**
+	 * @brief Frames of a camera that were overwritten before they could be dispatched
+	 * @param cameraId Camera ID
+	 */
+	uint64_t droppedFrames( int cameraId ) const
+	{
+		return m_cursors.value( cameraId ).dropped;
+	}
+
+	/**
+	 * @brief Get the delivery counters of a consumer
+	 * @param consumerId Handle returned by addConsumer()
+	 */
+	ConsumerStatistics consumerStatistics( int consumerId ) const;
+
+private:
+	/**
+	 * @struct Lane
+	 * @brief Queue of one consumer for one camera
+	 */
+	struct Lane
+	{
+		std::deque<FramePacketPtr> queue; ///< Frames waiting for the callback
+		bool draining = false;			  ///< A drain task is scheduled or running
+		bool backed_up = false;			  ///< Depth reached the high-water mark
+		uint64_t delivered = 0;			  ///< Frames handed to the callback
+		uint64_t dropped = 0;			  ///< Frames discarded by the policy
+		uint64_t high_water_events = 0;	  ///< Times the high-water mark was crossed
+		std::size_t max_depth = 0;		  ///< Deepest queue seen
+		uint64_t decimation_phase = 0;	  ///< Frames seen, for the variant's decimation
+		FramePool* pool = nullptr;		  ///< Buffers of the binned variant, created on demand
+	};
+
+	/**
+	 * @struct ConsumerState
+	 * @brief Queues of a consumer, shared with its drain tasks
+	 */
+	struct ConsumerState
+	{
+		/**
+		 * @brief Destructor, retires the lane pools
+		 */
+		~ConsumerState();
+
+		QString name;					 ///< Name used in logs
+		Callback callback;				 ///< Frame callback
+		BackpressurePolicy policy;		 ///< Queue handling
+		AcquisitionSettings variant;	 ///< Reduction of the delivered frames
+		std::mutex mutex;				 ///< Guards lanes
+		std::condition_variable changed; ///< Signalled when a lane shrinks or stops draining
+		std::map<int, Lane> lanes;		 ///< Queue per camera
+	};
+
+	/**
+	 * @struct Consumer
+	 * @brief One registered frame consumer
+	 */
+	struct Consumer
+	{
+		int id;								  ///< Handle returned by addConsumer()
+		std::shared_ptr<ConsumerState> state; ///< Callback and queues
+	};
+
+	/**
+	 * @brief Hand a packet to a consumer according to its policy
+	 */
+	void deliver( const std::shared_ptr<ConsumerState>& state, const FramePacketPtr& packet );
+
+	/**
+	 * @brief Apply the consumer's variant to a packet, on the thread running the callback
+	 */
+	static FramePacketPtr variantOf( ConsumerState& state, const FramePacketPtr& packet );
+
+	/**
+	 * @brief Schedule consumption of the next queued frame of a lane on the executor
+	 */
+	static void scheduleDrain( WorkStealingPool* executor, const std::shared_ptr<ConsumerState>& state, int cameraId );
+
+	/**
+	 * @brief Block until no lane of a consumer is draining
+	 */
+	static void waitIdle( ConsumerState& state );
+
+	/**
+	 * @brief Find a registered consumer
+	 */
+	std::shared_ptr<ConsumerState> stateOf( int consumerId ) const;
+
+	QVector<Consumer> m_consumers;				  ///< Registered consumers
+	QMap<int, FrameRingBuffer::Cursor> m_cursors; ///< Dispatch position per camera
+	WorkStealingPool* m_executor = nullptr;		  ///< Runs queued consumers
+	int m_next_consumer_id = 0;					  ///< Next consumer handle
+};
+
+#endif // FRAMEDISPATCHER_H
@@ -0,0 +1,242 @@
+#include "FramePool.h"
+#include "RealtimeScheduling.h"
+#include <QDebug>
+#include <new>
+
+FramePool* FramePool::create( const std::size_t maxFreeBuffers )
+{
+	return new FramePool( maxFreeBuffers );
+}
+
+FramePool::FramePool( const std::size_t maxFreeBuffers ) : m_max_free_buffers( maxFreeBuffers )
+{
+}
+
+FramePool::~FramePool()
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	clearFreeList();
+}
+
+void FramePool::retire()
+{
+	bool unused = false;
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		m_retired = true;
+		clearFreeList();
+		unused = m_outstanding == 0;
+	}
+
+	if ( unused )
+	{
+		delete this;
+	}
+}
+
+cv::Mat FramePool::createMat( const int rows, const int cols, const int type )
+{
+	cv::Mat mat;
+	mat.allocator = this;
+	mat.create( rows, cols, type );
+	return mat;
+}
+
+void FramePool::setLockMemory( const bool lock )
+{
+	std::lock_guard<std::mutex> lock_guard( m_mutex );
+	m_lock_memory = lock;
+	for ( const cv::UMatData* data : m_free )
+	{
+		lockBuffer( data->origdata, data->size );
+	}
+}
+
+bool FramePool::isMemoryLocked() const
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	return m_lock_memory;
+}
+
+FramePool::Statistics FramePool::statistics() const
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+
+	Statistics stats;
+	stats.heap_allocations = m_heap_allocations;
+	stats.reuses = m_reuses;
+	stats.free_buffers = m_free.size();
+	stats.outstanding = m_outstanding;
+	return stats;
+}
+
+QImage FramePool::wrapImage( const cv::Mat& mat, const QImage::Format format )
+{
+	if ( mat.empty() || !mat.u )
+	{
+		return {};
+	}
+
+	CV_XADD( &mat.u->refcount, 1 );
+	return QImage( mat.data, mat.cols, mat.rows, static_cast<int>( mat.step ), format, &FramePool::releaseImageBuffer,
+				   mat.u );
+}
+
+void FramePool::releaseImageBuffer( void* info )
+{
+	auto* data = static_cast<cv::UMatData*>( info );
+
+	// Same as cv::Mat::release() for the reference taken in wrapImage()
+	if ( CV_XADD( &data->refcount, -1 ) == 1 )
+	{
+		const cv::MatAllocator* allocator = data->currAllocator ? data->currAllocator : cv::Mat::getDefaultAllocator();
+		allocator->unmap( data );
+	}
+}
+
+cv::UMatData* FramePool::allocate( const int dims, const int* sizes, const int type, void* data0, size_t* step,
+								   cv::AccessFlag /*flags*/, cv::UMatUsageFlags /*usageFlags*/ ) const
+{
+	// Byte size and steps computed exactly like cv::StdMatAllocator
+	size_t total = CV_ELEM_SIZE( type );
+	for ( int i = dims - 1; i >= 0; i-- )
+	{
+		if ( step )
+		{
+			if ( data0 && step[i] != CV_AUTOSTEP )
+			{
+				CV_Assert( total <= step[i] );
+				total = step[i];
+			}
+			else
+			{
+				step[i] = total;
+			}
+		}
+		total *= sizes[i];
+	}
+
+	if ( data0 )
+	{
+		auto* data = new cv::UMatData( this );
+		data->data = data->origdata = static_cast<uchar*>( data0 );
+		data->size = total;
+		data->flags |= cv::UMatData::USER_ALLOCATED;
+		return data;
+	}
+
+	std::lock_guard<std::mutex> lock( m_mutex );
+
+	if ( total != m_buffer_size )
+	{
+		// Frame size changed: buffers of the old size are of no further use
+		clearFreeList();
+		m_buffer_size = total;
+	}
+
+	cv::UMatData* data = nullptr;
+	uchar* buffer = nullptr;
+	if ( !m_free.empty() )
+	{
+		data = m_free.back();
+		m_free.pop_back();
+		buffer = data->origdata;
+
+		// Reset the recycled header to the state of a freshly constructed one
+		data->~UMatData();
+		new ( data ) cv::UMatData( this );
+		++m_reuses;
+	}
+	else
+	{
+		data = new cv::UMatData( this );
+		buffer = static_cast<uchar*>( cv::fastMalloc( total ) );
+		lockBuffer( buffer, total );
+		++m_heap_allocations;
+	}
+
+	data->data = data->origdata = buffer;
+	data->size = total;
+	++m_outstanding;
+	return data;
+}
+
+bool FramePool::allocate( cv::UMatData* data, cv::AccessFlag /*accessflags*/, cv::UMatUsageFlags /*usageFlags*/ ) const
+{
+	return data != nullptr;
+}
+
+void FramePool::deallocate( cv::UMatData* data ) const
+{
+	if ( !data )
+	{
+		return;
+	}
+
+	CV_Assert( data->urefcount == 0 );
+	CV_Assert( data->refcount == 0 );
+
+	if ( data->flags & cv::UMatData::USER_ALLOCATED )
+	{
+		delete data;
+		return;
+	}
+
+	bool deleteSelf = false;
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		--m_outstanding;
+
+		if ( !m_retired && data->size == m_buffer_size && m_free.size() < m_max_free_buffers )
+		{
+			m_free.push_back( data );
+			return;
+		}
+
+		freeBuffer( data->origdata, data->size );
+		data->origdata = nullptr;
+		delete data;
+		deleteSelf = m_retired && m_outstanding == 0;
+	}
+
+	if ( deleteSelf )
+	{
+		delete const_cast<FramePool*>( this );
+	}
+}
+
+void FramePool::clearFreeList() const
+{
+	for ( cv::UMatData* data : m_free )
+	{
+		freeBuffer( data->origdata, data->size );
+		data->origdata = nullptr;
+		delete data;
+	}
+	m_free.clear();
+}
+
+void FramePool::lockBuffer( const uchar* buffer, const std::size_t size ) const
+{
+	if ( !m_lock_memory )
+	{
+		return;
+	}
+
+	m_locked_any = true;
+	if ( !RealtimeScheduling::lockBuffer( buffer, size ) )
+	{
+		m_lock_memory = false;
+		qWarning() << "[FramePool] cannot lock frame buffers into RAM (memory lock limit"
+				   << RealtimeScheduling::memoryLockLimit() << "bytes), continuing unlocked";
+	}
+}
+
+void FramePool::freeBuffer( uchar* buffer, const std::size_t size ) const
+{
+	if ( m_locked_any )
+	{
+		RealtimeScheduling::unlockBuffer( buffer, size );
+	}
+	cv::fastFree( buffer );
+}
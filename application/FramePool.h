@@ -0,0 +1,144 @@
+#ifndef FRAMEPOOL_H
+#define FRAMEPOOL_H
+
+#include <QImage>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <opencv2/core.hpp>
+
+/**
+ * @class FramePool
+ * @brief Recycling pool of same-size frame buffers exposed as a cv::MatAllocator
+ *
+ * A cv::Mat whose allocator is set to a FramePool takes its buffer (and the
+ * UMatData header) from the pool on create() and hands it back when the
+ * last reference is released, on whatever thread that happens. Once the
+ * pool is warm, steady-state streaming does no heap allocation. wrapImage()
+ * extends the same scheme to QImage through its cleanup hook.
+ *
+ * Pools are created with create() and given up with retire(); a retired
+ * pool deletes itself once every outstanding buffer has come back, so a
+ * consumer may keep a frame alive longer than the camera that produced it.
+ */
+class FramePool : public cv::MatAllocator
+{
+public:
+	/**
+	 * @struct Statistics
+	 * @brief Counters describing pool efficiency
+	 */
+	struct Statistics
+	{
+		uint64_t heap_allocations = 0; ///< Buffers that had to be allocated
+		uint64_t reuses = 0;		   ///< Buffers served from the free list
+		std::size_t free_buffers = 0;  ///< Buffers currently idle in the pool
+		std::size_t outstanding = 0;   ///< Buffers currently held by cv::Mat / QImage
+	};
+
+	static constexpr std::size_t kDefaultMaxFreeBuffers = 16; ///< Idle buffers kept for reuse
+
+	/**
+	 * @brief Create a pool
+	 * @param maxFreeBuffers Maximum number of idle buffers kept for reuse
+	 * @return New pool, to be given up with retire()
+	 */
+	static FramePool* create( std::size_t maxFreeBuffers = kDefaultMaxFreeBuffers );
+
+	/**
+	 * @brief Give up ownership; the pool is deleted once all buffers returned
+	 */
+	void retire();
+
+	/**
+	 * @brief Create a 2D Mat backed by this pool
+	 * @param rows Number of rows
+	 * @param cols Number of columns
+	 * @param type OpenCV type, e.g. CV_8UC3
+	 * @return Pooled Mat
+	 */
+	cv::Mat createMat( int rows, int cols, int type );
+
+	/**
+	 * @brief Lock pooled buffers into RAM so they are never paged out
+	 *
+	 * Applies to idle and future buffers. If the memory lock limit is hit,
+	 * locking is switched off again with a warning.
+	 *
+	 * @param lock true to lock, false to stop locking new buffers
+	 */
+	void setLockMemory( bool lock );
+
+	/**
+	 * @brief Check whether new buffers are locked into RAM
+	 */
+	bool isMemoryLocked() const;
+
+	/**
+	 * @brief Get the current pool counters
+	 */
+	Statistics statistics() const;
+
+	/**
+	 * @brief Wrap a Mat's buffer in a QImage without copying
+	 *
+	 * The QImage holds a reference on the Mat's buffer and releases it in its
+	 * cleanup hook, so a pooled buffer returns to its pool only once both the
+	 * Mat and the QImage are gone.
+	 *
+	 * @param mat Continuous 2D Mat
+	 * @param format QImage format matching the Mat's pixel layout
+	 * @return Image sharing the Mat's buffer, null image if mat is empty
+	 */
+	static QImage wrapImage( const cv::Mat& mat, QImage::Format format );
+
+	cv::UMatData* allocate( int dims, const int* sizes, int type, void* data0, size_t* step, cv::AccessFlag flags,
+							cv::UMatUsageFlags usageFlags ) const override;
+	bool allocate( cv::UMatData* data, cv::AccessFlag accessflags, cv::UMatUsageFlags usageFlags ) const override;
+	void deallocate( cv::UMatData* data ) const override;
+
+private:
+	/**
+	 * @brief Constructor, use create()
+	 */
+	explicit FramePool( std::size_t maxFreeBuffers );
+
+	/**
+	 * @brief Destructor, frees all idle buffers
+	 */
+	~FramePool() override;
+
+	/**
+	 * @brief QImage cleanup hook releasing the buffer reference taken by wrapImage()
+	 */
+	static void releaseImageBuffer( void* info );
+
+	/**
+	 * @brief Free all idle buffers (m_mutex must be held)
+	 */
+	void clearFreeList() const;
+
+	/**
+	 * @brief Lock a buffer if enabled, giving up on failure (m_mutex must be held)
+	 */
+	void lockBuffer( const uchar* buffer, std::size_t size ) const;
+
+	/**
+	 * @brief Free a buffer, unlocking it first if needed (m_mutex must be held)
+	 */
+	void freeBuffer( uchar* buffer, std::size_t size ) const;
+
+	mutable std::mutex m_mutex;					  ///< Guards all members below
+	mutable std::vector<cv::UMatData*> m_free;	  ///< Idle buffers with their headers
+	mutable std::size_t m_buffer_size = 0;		  ///< Byte size of pooled buffers
+	mutable std::size_t m_outstanding = 0;		  ///< Buffers handed out
+	mutable uint64_t m_heap_allocations = 0;	  ///< Buffers allocated from the heap
+	mutable uint64_t m_reuses = 0;				  ///< Buffers served from m_free
+	mutable bool m_lock_memory = false;			  ///< Lock new buffers into RAM
+	mutable bool m_locked_any = false;			  ///< Some buffer may be locked and needs unlocking
+	bool m_retired = false;						  ///< Set by retire()
+	std::size_t m_max_free_buffers;				  ///< Upper bound for m_free
+};
+
+#endif // FRAMEPOOL_H
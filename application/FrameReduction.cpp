@@ -0,0 +1,101 @@
+#include "FrameReduction.h"
+#include <algorithm>
+#include <memory>
+#include <opencv2/imgproc.hpp>
+
+cv::Mat FrameReduction::apply( const cv::Mat& frame, const PixelFormat format, const AcquisitionSettings& settings,
+							   cv::MatAllocator* allocator )
+{
+	if ( frame.empty() || !settings.reducesPixels() )
+	{
+		return frame;
+	}
+
+	const cv::Rect roi = effectiveRoi( frame.size(), format, settings );
+	if ( roi.empty() )
+	{
+		return {};
+	}
+	const cv::Mat cropped = frame( roi );
+
+	const int factor = std::max( settings.binning, 1 );
+	if ( factor == 1 )
+	{
+		return cropped;
+	}
+
+	cv::Mat binned;
+	binned.allocator = allocator;
+	if ( isBayer( format ) )
+	{
+		binBayer( cropped, binned, factor );
+	}
+	else
+	{
+		// Integer factor on a block-aligned region: INTER_AREA is the exact block mean
+		cv::resize( cropped, binned, cv::Size( cropped.cols / factor, cropped.rows / factor ), 0.0, 0.0,
+					cv::INTER_AREA );
+	}
+	return binned;
+}
+
+FramePacketPtr FrameReduction::apply( const FramePacketPtr& packet, const AcquisitionSettings& settings,
+									  cv::MatAllocator* allocator )
+{
+	if ( !packet || ( !settings.reducesPixels() && settings.decimation <= 1 ) )
+	{
+		return packet;
+	}
+
+	auto reduced = std::make_shared<FramePacket>( *packet );
+	if ( settings.reducesPixels() )
+	{
+		reduced->frame = apply( packet->frame, packet->pixel_format, settings, allocator );
+	}
+	reduced->stream_fps = packet->stream_fps / std::max( settings.decimation, 1 );
+	return reduced;
+}
+
+cv::Rect FrameReduction::effectiveRoi( const cv::Size& frameSize, const PixelFormat format,
+									   const AcquisitionSettings& settings )
+{
+	const cv::Rect full( 0, 0, frameSize.width, frameSize.height );
+	cv::Rect roi = settings.roi.empty() ? full : ( settings.roi & full );
+
+	// Bayer frames are binned per 2x2 cell, so blocks span 2 * binning pixels
+	const int block = std::max( settings.binning, 1 ) * ( isBayer( format ) ? 2 : 1 );
+	const int x = ( roi.x + block - 1 ) / block * block;
+	const int y = ( roi.y + block - 1 ) / block * block;
+	const int width = ( roi.x + roi.width - x ) / block * block;
+	const int height = ( roi.y + roi.height - y ) / block * block;
+	return width > 0 && height > 0 ? cv::Rect( x, y, width, height ) : cv::Rect();
+}
+
+void FrameReduction::binBayer( const cv::Mat& src, cv::Mat& dst, const int factor )
+{
+	dst.create( src.rows / factor, src.cols / factor, src.type() );
+
+	// Output pixel (y, x) keeps the colour of its position in the 2x2 cell and averages the
+	// factor x factor pixels of that colour in the corresponding 2 * factor block of src
+	const int samples = factor * factor;
+	const int block = 2 * factor;
+	for ( int y = 0; y < dst.rows; ++y )
+	{
+		const int src_row = ( y / 2 ) * block + ( y % 2 );
+		uchar* out = dst.ptr<uchar>( y );
+		for ( int x = 0; x < dst.cols; ++x )
+		{
+			const int src_col = ( x / 2 ) * block + ( x % 2 );
+			int sum = 0;
+			for ( int i = 0; i < factor; ++i )
+			{
+				const uchar* in = src.ptr<uchar>( src_row + 2 * i ) + src_col;
+				for ( int j = 0; j < factor; ++j )
+				{
+					sum += in[2 * j];
+				}
+			}
+			out[x] = static_cast<uchar>( ( sum + samples / 2 ) / samples );
+		}
+	}
+}
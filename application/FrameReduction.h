@@ -0,0 +1,55 @@
+#ifndef FRAMEREDUCTION_H
+#define FRAMEREDUCTION_H
+
+#include "AcquisitionSettings.h"
+#include "FramePacket.h"
+#include <opencv2/core.hpp>
+
+/**
+ * @class FrameReduction
+ * @brief Software region of interest and binning for any PixelFormat
+ *
+ * Cropping is free: the result is a view into the original buffer. Binning
+ * averages blocks of binning x binning pixels; Bayer frames are binned per
+ * colour, so the result is again a Bayer frame of the same pattern. The
+ * region of interest is aligned to whole blocks (and Bayer cells), so the
+ * pattern and the block grid stay intact.
+ */
+class FrameReduction
+{
+public:
+	/**
+	 * @brief Crop and bin a frame
+	 * @param frame Frame to reduce
+	 * @param format Layout of frame
+	 * @param settings Region of interest and binning; decimation is ignored
+	 * @param allocator Allocator of a binned frame, e.g. a FramePool; nullptr for the default
+	 * @return Reduced frame, a view into frame if it is only cropped
+	 */
+	static cv::Mat apply( const cv::Mat& frame, PixelFormat format, const AcquisitionSettings& settings,
+						  cv::MatAllocator* allocator = nullptr );
+
+	/**
+	 * @brief Reduce the frame of a packet
+	 *
+	 * The caller drops the decimated packets; the result's stream_fps accounts for them.
+	 *
+	 * @return New packet with the reduced frame and stream rate; packet itself if nothing is reduced
+	 */
+	static FramePacketPtr apply( const FramePacketPtr& packet, const AcquisitionSettings& settings,
+								 cv::MatAllocator* allocator = nullptr );
+
+	/**
+	 * @brief Region of interest actually used for a frame size
+	 * @return settings.roi clipped to the frame and aligned to the binning block and Bayer cell
+	 */
+	static cv::Rect effectiveRoi( const cv::Size& frameSize, PixelFormat format, const AcquisitionSettings& settings );
+
+private:
+	/**
+	 * @brief Bin an 8-bit Bayer frame per colour; src dimensions are multiples of 2 * factor
+	 */
+	static void binBayer( const cv::Mat& src, cv::Mat& dst, int factor );
+};
+
+#endif // FRAMEREDUCTION_H
@@ -0,0 +1,122 @@
+#include "FrameRingBuffer.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <utility>
+
+FrameRingBuffer::FrameRingBuffer( const std::size_t capacity ) :
+	m_capacity( std::max<std::size_t>( capacity, 2 ) ), m_slots( new Slot[m_capacity] )
+{
+}
+
+void FrameRingBuffer::push( FramePacketPtr packet )
+{
+	const uint64_t position = m_write_index.load( std::memory_order_relaxed );
+	writeSlot( m_slots[position % m_capacity], position, std::move( packet ) );
+	m_write_index.store( position + 1, std::memory_order_release );
+}
+
+void FrameRingBuffer::writeSlot( Slot& slot, const uint64_t position, FramePacketPtr packet )
+{
+	// Mark the slot as being written, then wait for readers that pinned it before the mark.
+	// Readers only hold a pin while copying a packet handle, so this never waits on consumer work.
+	const uint64_t sequence = slot.sequence.load( std::memory_order_relaxed );
+	slot.sequence.store( sequence + 1, std::memory_order_seq_cst );
+	for ( int attempt = 0; slot.readers.load( std::memory_order_seq_cst ) != 0; ++attempt )
+	{
+		// A yield does not hand the core to a lower-priority reader when the producer runs
+		// SCHED_FIFO; after a short spin, sleep so a preempted reader can drop its pin
+		if ( attempt < kPinSpinLimit )
+		{
+			std::this_thread::yield();
+		}
+		else
+		{
+			std::this_thread::sleep_for( kPinBackoff );
+		}
+	}
+
+	slot.packet = std::move( packet );
+	slot.position = position;
+	slot.sequence.store( sequence + 2, std::memory_order_release );
+}
+
+bool FrameRingBuffer::readPosition( const uint64_t position, FramePacketPtr& out ) const
+{
+	Slot& slot = m_slots[position % m_capacity];
+
+	slot.readers.fetch_add( 1, std::memory_order_seq_cst );
+	const uint64_t sequence = slot.sequence.load( std::memory_order_seq_cst );
+
+	// With the pin visible to the producer and an even sequence, the slot cannot change under us
+	const bool ok = ( sequence & 1 ) == 0 && slot.position == position && slot.packet;
+	if ( ok )
+	{
+		out = slot.packet;
+	}
+
+	slot.readers.fetch_sub( 1, std::memory_order_release );
+	return ok;
+}
+
+bool FrameRingBuffer::readLatest( FramePacketPtr& out ) const
+{
+	// The latest slot is only rewritten after the producer lapped the whole ring, so retries are rare
+	for ( int attempt = 0; attempt < 4; ++attempt )
+	{
+		const uint64_t written = m_write_index.load( std::memory_order_acquire );
+		if ( written == 0 )
+		{
+			return false;
+		}
+		if ( readPosition( written - 1, out ) )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FrameRingBuffer::readNext( Cursor& cursor, FramePacketPtr& out ) const
+{
+	while ( true )
+	{
+		const uint64_t written = m_write_index.load( std::memory_order_acquire );
+		if ( cursor.next >= written )
+		{
+			return false;
+		}
+
+		if ( written - cursor.next > m_capacity )
+		{
+			const uint64_t oldest = written - m_capacity;
+			cursor.dropped += oldest - cursor.next;
+			cursor.next = oldest;
+		}
+
+		if ( readPosition( cursor.next, out ) )
+		{
+			++cursor.next;
+			return true;
+		}
+
+		// The slot was overwritten while we were reading it: count it lost and move on
+		++cursor.dropped;
+		++cursor.next;
+	}
+}
+
+FrameRingBuffer::Cursor FrameRingBuffer::cursorAtHead() const
+{
+	Cursor cursor;
+	cursor.next = m_write_index.load( std::memory_order_acquire );
+	return cursor;
+}
+
+void FrameRingBuffer::clear()
+{
+	for ( std::size_t i = 0; i < m_capacity; ++i )
+	{
+		writeSlot( m_slots[i], m_slots[i].position, nullptr );
+	}
+}
@@ -0,0 +1,130 @@
+#ifndef FRAMERINGBUFFER_H
+#define FRAMERINGBUFFER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "FramePacket.h"
+
+/**
+ * @class FrameRingBuffer
+ * @brief Bounded single-producer/multi-consumer FramePacket ring without locks
+ *
+ * The acquisition thread of a camera is the only producer. Any number of
+ * consumers (display, VideoSaver, analytics) read at their own pace, either
+ * the latest frame (preview) or every frame in order through their own
+ * Cursor (recording). Readers never take a mutex and never hold a slot
+ * beyond copying its packet handle, so a slow consumer cannot stall the
+ * producer; it only loses the frames that were overwritten in the meantime.
+ */
+class FrameRingBuffer
+{
+public:
+	/**
+	 * @struct Cursor
+	 * @brief Read position of one in-order consumer
+	 */
+	struct Cursor
+	{
+		uint64_t next = 0;	  ///< Position of the next entry to read
+		uint64_t dropped = 0; ///< Packets overwritten before this consumer read them
+	};
+
+	static constexpr std::size_t kDefaultCapacity = 8; ///< Default number of slots
+
+	/**
+	 * @brief Constructor
+	 * @param capacity Number of slots (at least 2)
+	 */
+	explicit FrameRingBuffer( std::size_t capacity = kDefaultCapacity );
+
+	FrameRingBuffer( const FrameRingBuffer& ) = delete;
+	FrameRingBuffer& operator=( const FrameRingBuffer& ) = delete;
+
+	/**
+	 * @brief Publish a packet (producer thread only)
+	 * @param packet Packet to publish
+	 */
+	void push( FramePacketPtr packet );
+
+	/**
+	 * @brief Read the most recently published packet (latest wins)
+	 * @param out Receives the packet
+	 * @return false if nothing has been published yet
+	 */
+	bool readLatest( FramePacketPtr& out ) const;
+
+	/**
+	 * @brief Read the next packet in publication order
+	 *
+	 * If the producer lapped the cursor, the cursor skips forward to the
+	 * oldest packet still available and counts the skipped packets.
+	 *
+	 * @param cursor Consumer read position, advanced on success
+	 * @param out Receives the packet
+	 * @return false if the cursor is caught up
+	 */
+	bool readNext( Cursor& cursor, FramePacketPtr& out ) const;
+
+	/**
+	 * @brief Create a cursor that starts with the next published packet
+	 * @return Cursor positioned at the write head
+	 */
+	Cursor cursorAtHead() const;
+
+	/**
+	 * @brief Total number of packets published so far
+	 */
+	uint64_t published() const
+	{
+		return m_write_index.load( std::memory_order_acquire );
+	}
+
+	/**
+	 * @brief Number of slots
+	 */
+	std::size_t capacity() const
+	{
+		return m_capacity;
+	}
+
+	/**
+	 * @brief Drop all packets (only while the producer is stopped)
+	 */
+	void clear();
+
+private:
+	/**
+	 * @struct Slot
+	 * @brief Storage for one packet, guarded by a sequence and a reader pin count
+	 */
+	struct alignas( 64 ) Slot
+	{
+		std::atomic<uint64_t> sequence { 0 }; ///< Odd while the producer writes
+		std::atomic<uint32_t> readers { 0 };  ///< Readers currently copying the packet handle
+		uint64_t position = 0;				  ///< Ring position held by the slot
+		FramePacketPtr packet;				  ///< Published packet
+	};
+
+	/**
+	 * @brief Replace the packet of a slot, waiting out readers that pinned it
+	 */
+	void writeSlot( Slot& slot, uint64_t position, FramePacketPtr packet );
+
+	/**
+	 * @brief Copy the packet handle at a ring position if it is still present
+	 * @return false if the slot is being written or holds another position
+	 */
+	bool readPosition( uint64_t position, FramePacketPtr& out ) const;
+
+	static constexpr int kPinSpinLimit = 64; ///< Yields before the producer sleeps on a pinned slot
+	static constexpr std::chrono::microseconds kPinBackoff { 20 }; ///< Producer sleep while a slot stays pinned
+
+	std::size_t m_capacity;				   ///< Number of slots
+	std::unique_ptr<Slot[]> m_slots;	   ///< Slot storage
+	alignas( 64 ) std::atomic<uint64_t> m_write_index { 0 }; ///< Number of published packets
+};
+
+#endif // FRAMERINGBUFFER_H
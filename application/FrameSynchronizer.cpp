@@ -0,0 +1,114 @@
+#include "FrameSynchronizer.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+void FrameSynchronizer::configure( const QVector<int>& cameraIds, const int64_t toleranceNs,
+								   const std::size_t queueDepth )
+{
+	clear();
+
+	m_camera_ids = cameraIds;
+	m_tolerance_ns = std::max<int64_t>( toleranceNs, 0 );
+	m_queue_depth = std::max<std::size_t>( queueDepth, 1 );
+	m_queues.resize( static_cast<std::size_t>( cameraIds.size() ) );
+
+	for ( int i = 0; i < cameraIds.size(); ++i )
+	{
+		m_slot_of_camera.insert( cameraIds[i], i );
+	}
+}
+
+void FrameSynchronizer::clear()
+{
+	m_camera_ids.clear();
+	m_slot_of_camera.clear();
+	m_queues.clear();
+	m_statistics = Statistics();
+}
+
+void FrameSynchronizer::setCallback( Callback callback )
+{
+	m_callback = std::move( callback );
+}
+
+void FrameSynchronizer::push( const FramePacketPtr& packet )
+{
+	if ( !packet )
+	{
+		return;
+	}
+
+	const auto slot = m_slot_of_camera.constFind( packet->camera_id );
+	if ( slot == m_slot_of_camera.constEnd() )
+	{
+		return;
+	}
+
+	std::deque<FramePacketPtr>& queue = m_queues[static_cast<std::size_t>( slot.value() )];
+	queue.push_back( packet );
+	if ( queue.size() > m_queue_depth )
+	{
+		queue.pop_front();
+		++m_statistics.discarded;
+	}
+
+	match();
+}
+
+void FrameSynchronizer::match()
+{
+	while ( true )
+	{
+		// The newest of the oldest pending captures is the earliest instant every camera can still match
+		int64_t reference = std::numeric_limits<int64_t>::min();
+		for ( const auto& queue : m_queues )
+		{
+			if ( queue.empty() )
+			{
+				return;
+			}
+			reference = std::max( reference, queue.front()->timestamp_ns );
+		}
+
+		// Discard captures too old to ever fall within the tolerance of the reference
+		bool discarded = false;
+		for ( auto& queue : m_queues )
+		{
+			while ( !queue.empty() && queue.front()->timestamp_ns < reference - m_tolerance_ns )
+			{
+				queue.pop_front();
+				++m_statistics.discarded;
+				discarded = true;
+			}
+		}
+		if ( discarded )
+		{
+			// A pruned queue may now start later than the reference: re-evaluate
+			continue;
+		}
+
+		FrameSet set;
+		set.packets.reserve( static_cast<int>( m_queues.size() ) );
+		int64_t earliest = std::numeric_limits<int64_t>::max();
+		for ( auto& queue : m_queues )
+		{
+			earliest = std::min( earliest, queue.front()->timestamp_ns );
+			set.packets.append( std::move( queue.front() ) );
+			queue.pop_front();
+		}
+		set.timestamp_ns = reference;
+		set.skew_ns = reference - earliest;
+
+		++m_statistics.sets;
+		m_statistics.last_skew_ns = set.skew_ns;
+		m_statistics.max_skew_ns = std::max( m_statistics.max_skew_ns, set.skew_ns );
+		m_statistics.mean_skew_ns +=
+			( static_cast<double>( set.skew_ns ) - m_statistics.mean_skew_ns ) / static_cast<double>( m_statistics.sets );
+
+		if ( m_callback )
+		{
+			m_callback( set );
+		}
+	}
+}
@@ -0,0 +1,123 @@
+#ifndef FRAMESYNCHRONIZER_H
+#define FRAMESYNCHRONIZER_H
+
+#include "FramePacket.h"
+#include <QHash>
+#include <QMetaType>
+#include <QVector>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+/**
+ * @struct FrameSet
+ * @brief Frames of a camera group that were captured at (nearly) the same instant
+ */
+struct FrameSet
+{
+	QVector<FramePacketPtr> packets; ///< One packet per group camera, in group order
+	int64_t timestamp_ns = 0;		 ///< Latest capture timestamp in the set
+	int64_t skew_ns = 0;			 ///< Spread between earliest and latest capture in the set
+};
+
+Q_DECLARE_METATYPE( FrameSet )
+
+/**
+ * @class FrameSynchronizer
+ * @brief Groups packets of several cameras into FrameSets by capture timestamp
+ *
+ * Packets are pushed per camera in capture order. As soon as every camera of
+ * the group holds a packet whose capture time lies within the tolerance of
+ * the others, the matching packets are emitted as a FrameSet. Packets that
+ * can no longer be matched are discarded, and each camera's queue is bounded,
+ * so a stalled camera never makes the synchronizer buffer without limit.
+ */
+class FrameSynchronizer
+{
+public:
+	/**
+	 * @brief Callback receiving each completed FrameSet
+	 */
+	using Callback = std::function<void( const FrameSet& set )>;
+
+	/**
+	 * @struct Statistics
+	 * @brief Matching counters and measured inter-camera skew
+	 */
+	struct Statistics
+	{
+		uint64_t sets = 0;			 ///< FrameSets emitted
+		uint64_t discarded = 0;		 ///< Packets that could not be matched
+		int64_t last_skew_ns = 0;	 ///< Skew of the latest set
+		int64_t max_skew_ns = 0;	 ///< Largest skew seen
+		double mean_skew_ns = 0.0;	 ///< Mean skew over all sets
+	};
+
+	static constexpr std::size_t kDefaultQueueDepth = 8; ///< Packets buffered per camera
+
+	/**
+	 * @brief Configure the camera group; drops all buffered packets and counters
+	 * @param cameraIds Cameras whose frames form a set
+	 * @param toleranceNs Maximum capture time spread within a set in ns
+	 * @param queueDepth Packets buffered per camera before the oldest is discarded
+	 */
+	void configure( const QVector<int>& cameraIds, int64_t toleranceNs, std::size_t queueDepth = kDefaultQueueDepth );
+
+	/**
+	 * @brief Remove the camera group
+	 */
+	void clear();
+
+	/**
+	 * @brief Set the callback receiving completed sets
+	 */
+	void setCallback( Callback callback );
+
+	/**
+	 * @brief Feed a packet; emits every FrameSet it completes
+	 * @param packet Packet of any camera, ignored if not in the group
+	 */
+	void push( const FramePacketPtr& packet );
+
+	/**
+	 * @brief Check whether a group is configured
+	 */
+	bool isActive() const
+	{
+		return !m_camera_ids.isEmpty();
+	}
+
+	/**
+	 * @brief Get the cameras of the group
+	 */
+	const QVector<int>& cameraIds() const
+	{
+		return m_camera_ids;
+	}
+
+	/**
+	 * @brief Get the matching counters
+	 */
+	const Statistics& statistics() const
+	{
+		return m_statistics;
+	}
+
+private:
+	/**
+	 * @brief Emit sets while every queue can contribute a matching packet
+	 */
+	void match();
+
+	QVector<int> m_camera_ids;						 ///< Group cameras in set order
+	QHash<int, int> m_slot_of_camera;				 ///< Camera ID to index in m_queues
+	std::vector<std::deque<FramePacketPtr>> m_queues; ///< Pending packets per group camera
+	int64_t m_tolerance_ns = 0;						 ///< Maximum spread within a set
+	std::size_t m_queue_depth = kDefaultQueueDepth;	 ///< Bound of each queue
+	Callback m_callback;							 ///< Receives completed sets
+	Statistics m_statistics;						 ///< Matching counters
+};
+
+#endif // FRAMESYNCHRONIZER_H
@@ -0,0 +1,379 @@
+#include "PixelConversion.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <opencv2/core/utility.hpp>
+#include <opencv2/imgproc.hpp>
+
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 )
+#include <immintrin.h>
+#define MULTICAM_SIMD_X86
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define MULTICAM_TARGET( isa ) __attribute__( ( target( isa ) ) )
+#else
+#define MULTICAM_TARGET( isa )
+#endif
+#elif defined( __ARM_NEON )
+#include <arm_neon.h>
+#define MULTICAM_SIMD_NEON
+#endif
+
+namespace
+{
+/// Adds one row of 8-bit samples to 32-bit column sums: acc[i] += row[i]
+using AccumulateRow = void ( * )( const uchar* row, uint32_t* acc, int count );
+
+void accumulateScalar( const uchar* row, uint32_t* acc, const int count )
+{
+	for ( int i = 0; i < count; ++i )
+	{
+		acc[i] += row[i];
+	}
+}
+
+#ifdef MULTICAM_SIMD_X86
+MULTICAM_TARGET( "sse4.1" ) void accumulateSse41( const uchar* row, uint32_t* acc, const int count )
+{
+	int i = 0;
+	for ( ; i + 16 <= count; i += 16 )
+	{
+		const __m128i bytes = _mm_loadu_si128( reinterpret_cast<const __m128i*>( row + i ) );
+		// Widen four bytes at a time; the shifts bring the next four to the bottom
+		const __m128i widened[4] = { _mm_cvtepu8_epi32( bytes ), _mm_cvtepu8_epi32( _mm_srli_si128( bytes, 4 ) ),
+									 _mm_cvtepu8_epi32( _mm_srli_si128( bytes, 8 ) ),
+									 _mm_cvtepu8_epi32( _mm_srli_si128( bytes, 12 ) ) };
+		for ( int part = 0; part < 4; ++part )
+		{
+			__m128i* sums = reinterpret_cast<__m128i*>( acc + i + 4 * part );
+			_mm_storeu_si128( sums, _mm_add_epi32( _mm_loadu_si128( sums ), widened[part] ) );
+		}
+	}
+	accumulateScalar( row + i, acc + i, count - i );
+}
+
+MULTICAM_TARGET( "avx2" ) void accumulateAvx2( const uchar* row, uint32_t* acc, const int count )
+{
+	int i = 0;
+	for ( ; i + 16 <= count; i += 16 )
+	{
+		const __m128i bytes = _mm_loadu_si128( reinterpret_cast<const __m128i*>( row + i ) );
+		__m256i* low = reinterpret_cast<__m256i*>( acc + i );
+		__m256i* high = reinterpret_cast<__m256i*>( acc + i + 8 );
+		_mm256_storeu_si256( low, _mm256_add_epi32( _mm256_loadu_si256( low ), _mm256_cvtepu8_epi32( bytes ) ) );
+		_mm256_storeu_si256( high, _mm256_add_epi32( _mm256_loadu_si256( high ),
+													 _mm256_cvtepu8_epi32( _mm_srli_si128( bytes, 8 ) ) ) );
+	}
+	accumulateScalar( row + i, acc + i, count - i );
+}
+#endif
+
+#ifdef MULTICAM_SIMD_NEON
+void accumulateNeon( const uchar* row, uint32_t* acc, const int count )
+{
+	int i = 0;
+	for ( ; i + 16 <= count; i += 16 )
+	{
+		const uint8x16_t bytes = vld1q_u8( row + i );
+		const uint16x8_t low = vmovl_u8( vget_low_u8( bytes ) );
+		const uint16x8_t high = vmovl_u8( vget_high_u8( bytes ) );
+		vst1q_u32( acc + i, vaddw_u16( vld1q_u32( acc + i ), vget_low_u16( low ) ) );
+		vst1q_u32( acc + i + 4, vaddw_u16( vld1q_u32( acc + i + 4 ), vget_high_u16( low ) ) );
+		vst1q_u32( acc + i + 8, vaddw_u16( vld1q_u32( acc + i + 8 ), vget_low_u16( high ) ) );
+		vst1q_u32( acc + i + 12, vaddw_u16( vld1q_u32( acc + i + 12 ), vget_high_u16( high ) ) );
+	}
+	accumulateScalar( row + i, acc + i, count - i );
+}
+#endif
+
+AccumulateRow selectAccumulateRow()
+{
+#if defined( MULTICAM_SIMD_X86 )
+	if ( cv::checkHardwareSupport( CV_CPU_AVX2 ) )
+	{
+		return accumulateAvx2;
+	}
+	if ( cv::checkHardwareSupport( CV_CPU_SSE4_1 ) )
+	{
+		return accumulateSse41;
+	}
+#elif defined( MULTICAM_SIMD_NEON )
+	return accumulateNeon;
+#endif
+	return accumulateScalar;
+}
+
+/// Implementation for this CPU, picked once
+AccumulateRow accumulateRow()
+{
+	static const AccumulateRow selected = selectAccumulateRow();
+	return selected;
+}
+
+/// First source index of every output index, plus the end: output i covers [bounds[i], bounds[i + 1])
+std::vector<int> areaBounds( const int sourceLength, const int targetLength )
+{
+	std::vector<int> bounds( targetLength + 1 );
+	for ( int i = 0; i <= targetLength; ++i )
+	{
+		bounds[i] = static_cast<int>( static_cast<int64_t>( i ) * sourceLength / targetLength );
+	}
+	return bounds;
+}
+
+uchar average( const uint32_t sum, const uint32_t count )
+{
+	return static_cast<uchar>( ( sum + count / 2 ) / count );
+}
+} // namespace
+
+void PixelConversion::toColor8( const cv::Mat& src, const PixelFormat format, cv::Mat& dst, const ChannelOrder order,
+								const cv::Size& targetSize )
+{
+	const bool rgb = order == ChannelOrder::Rgb;
+	switch ( format )
+	{
+	case PixelFormat::Bgr8:
+		if ( rgb )
+		{
+			cv::cvtColor( src, dst, cv::COLOR_BGR2RGB );
+		}
+		else
+		{
+			src.copyTo( dst );
+		}
+		return;
+	case PixelFormat::Mono8:
+		cv::cvtColor( src, dst, cv::COLOR_GRAY2BGR );
+		return;
+	case PixelFormat::Mono16:
+	{
+		cv::Mat mono8;
+		src.convertTo( mono8, CV_8U, 1.0 / 256.0 );
+		cv::cvtColor( mono8, dst, cv::COLOR_GRAY2BGR );
+		return;
+	}
+	default:
+		break;
+	}
+
+	if ( usesHalfResolution( src, format, targetSize ) )
+	{
+		demosaicHalf( src, format, dst, order );
+	}
+	else
+	{
+		demosaic( src, format, dst, order );
+	}
+}
+
+bool PixelConversion::resizeToColor8( const cv::Mat& src, const PixelFormat format, cv::Mat& dst,
+									  const ChannelOrder order, const cv::Size& targetSize )
+{
+	if ( src.empty() || targetSize.empty() || src.depth() != CV_8U || ( isBayer( format ) && src.channels() != 1 ) )
+	{
+		return false;
+	}
+
+	if ( isBayer( format ) )
+	{
+		if ( targetSize.width * 2 > src.cols || targetSize.height * 2 > src.rows )
+		{
+			return false;
+		}
+		dst.create( targetSize, CV_8UC3 );
+		resizeBayer( src, format, dst, order );
+		return true;
+	}
+
+	const int channels = format == PixelFormat::Bgr8 ? 3 : 1;
+	if ( ( format != PixelFormat::Bgr8 && format != PixelFormat::Mono8 ) || src.channels() != channels ||
+		 targetSize.width > src.cols || targetSize.height > src.rows )
+	{
+		return false;
+	}
+	dst.create( targetSize, CV_8UC3 );
+	resizePacked( src, channels, dst, order );
+	return true;
+}
+
+void PixelConversion::resizePacked( const cv::Mat& src, const int channels, cv::Mat& dst, const ChannelOrder order )
+{
+	const AccumulateRow accumulate = accumulateRow();
+	const std::vector<int> rows = areaBounds( src.rows, dst.rows );
+	const std::vector<int> cols = areaBounds( src.cols, dst.cols );
+	const int rowLength = src.cols * channels;
+	const bool swap = channels == 3 && order == ChannelOrder::Rgb;
+
+	// Column sums of the source rows covered by one output row
+	thread_local std::vector<uint32_t> sums;
+	sums.resize( rowLength );
+
+	for ( int y = 0; y < dst.rows; ++y )
+	{
+		std::memset( sums.data(), 0, sums.size() * sizeof( uint32_t ) );
+		for ( int sy = rows[y]; sy < rows[y + 1]; ++sy )
+		{
+			accumulate( src.ptr<uchar>( sy ), sums.data(), rowLength );
+		}
+
+		const uint32_t height = rows[y + 1] - rows[y];
+		uchar* out = dst.ptr<uchar>( y );
+		for ( int x = 0; x < dst.cols; ++x, out += 3 )
+		{
+			const uint32_t count = height * ( cols[x + 1] - cols[x] );
+			if ( channels == 1 )
+			{
+				uint32_t sum = 0;
+				for ( int sx = cols[x]; sx < cols[x + 1]; ++sx )
+				{
+					sum += sums[sx];
+				}
+				out[0] = out[1] = out[2] = average( sum, count );
+				continue;
+			}
+
+			uint32_t sum[3] = { 0, 0, 0 };
+			for ( int sx = cols[x]; sx < cols[x + 1]; ++sx )
+			{
+				sum[0] += sums[3 * sx];
+				sum[1] += sums[3 * sx + 1];
+				sum[2] += sums[3 * sx + 2];
+			}
+			out[0] = average( sum[swap ? 2 : 0], count );
+			out[1] = average( sum[1], count );
+			out[2] = average( sum[swap ? 0 : 2], count );
+		}
+	}
+}
+
+void PixelConversion::resizeBayer( const cv::Mat& src, const PixelFormat format, cv::Mat& dst,
+								   const ChannelOrder order )
+{
+	int red = 0;
+	int blue = 3;
+	bayerCell( format, red, blue );
+	const int first = order == ChannelOrder::Rgb ? red : blue;
+	const int last = order == ChannelOrder::Rgb ? blue : red;
+
+	// Works on 2x2 cells: every output pixel averages the cells it covers, colour by colour
+	const AccumulateRow accumulate = accumulateRow();
+	const std::vector<int> rows = areaBounds( src.rows / 2, dst.rows );
+	const std::vector<int> cols = areaBounds( src.cols / 2, dst.cols );
+	const int rowLength = ( src.cols / 2 ) * 2;
+
+	// Column sums of the top and the bottom rows of the covered cells
+	thread_local std::vector<uint32_t> sums;
+	sums.resize( 2 * rowLength );
+	uint32_t* top = sums.data();
+	uint32_t* bottom = sums.data() + rowLength;
+
+	for ( int y = 0; y < dst.rows; ++y )
+	{
+		std::memset( sums.data(), 0, sums.size() * sizeof( uint32_t ) );
+		for ( int cy = rows[y]; cy < rows[y + 1]; ++cy )
+		{
+			accumulate( src.ptr<uchar>( 2 * cy ), top, rowLength );
+			accumulate( src.ptr<uchar>( 2 * cy + 1 ), bottom, rowLength );
+		}
+
+		const uint32_t height = rows[y + 1] - rows[y];
+		uchar* out = dst.ptr<uchar>( y );
+		for ( int x = 0; x < dst.cols; ++x, out += 3 )
+		{
+			uint32_t cell[4] = { 0, 0, 0, 0 };
+			for ( int cx = cols[x]; cx < cols[x + 1]; ++cx )
+			{
+				cell[0] += top[2 * cx];
+				cell[1] += top[2 * cx + 1];
+				cell[2] += bottom[2 * cx];
+				cell[3] += bottom[2 * cx + 1];
+			}
+			const uint32_t count = height * ( cols[x + 1] - cols[x] );
+			const uint32_t green = cell[0] + cell[1] + cell[2] + cell[3] - cell[red] - cell[blue];
+			out[0] = average( cell[first], count );
+			out[1] = average( green, 2 * count );
+			out[2] = average( cell[last], count );
+		}
+	}
+}
+
+bool PixelConversion::usesHalfResolution( const cv::Mat& src, const PixelFormat format, const cv::Size& targetSize )
+{
+	return isBayer( format ) && !targetSize.empty() && targetSize.width * 2 <= src.cols &&
+		   targetSize.height * 2 <= src.rows;
+}
+
+void PixelConversion::demosaic( const cv::Mat& src, const PixelFormat format, cv::Mat& dst, const ChannelOrder order )
+{
+	// OpenCV names its Bayer codes after the second row of the pattern, hence the crossed mapping
+	const bool rgb = order == ChannelOrder::Rgb;
+	int code = 0;
+	switch ( format )
+	{
+	case PixelFormat::BayerRG8:
+		code = rgb ? cv::COLOR_BayerBG2RGB : cv::COLOR_BayerBG2BGR;
+		break;
+	case PixelFormat::BayerGB8:
+		code = rgb ? cv::COLOR_BayerGR2RGB : cv::COLOR_BayerGR2BGR;
+		break;
+	case PixelFormat::BayerGR8:
+		code = rgb ? cv::COLOR_BayerGB2RGB : cv::COLOR_BayerGB2BGR;
+		break;
+	case PixelFormat::BayerBG8:
+		code = rgb ? cv::COLOR_BayerRG2RGB : cv::COLOR_BayerRG2BGR;
+		break;
+	default:
+		return;
+	}
+	cv::cvtColor( src, dst, code );
+}
+
+void PixelConversion::demosaicHalf( const cv::Mat& src, const PixelFormat format, cv::Mat& dst,
+									const ChannelOrder order )
+{
+	int red = 0;
+	int blue = 3;
+	bayerCell( format, red, blue );
+	const int first = order == ChannelOrder::Rgb ? red : blue;
+	const int last = order == ChannelOrder::Rgb ? blue : red;
+
+	dst.create( src.rows / 2, src.cols / 2, CV_8UC3 );
+	for ( int y = 0; y < dst.rows; ++y )
+	{
+		const uchar* top = src.ptr<uchar>( 2 * y );
+		const uchar* bottom = src.ptr<uchar>( 2 * y + 1 );
+		uchar* out = dst.ptr<uchar>( y );
+		for ( int x = 0; x < dst.cols; ++x )
+		{
+			const int cell[4] = { top[2 * x], top[2 * x + 1], bottom[2 * x], bottom[2 * x + 1] };
+			const int sum = cell[0] + cell[1] + cell[2] + cell[3];
+			out[3 * x] = static_cast<uchar>( cell[first] );
+			out[3 * x + 1] = static_cast<uchar>( ( sum - cell[red] - cell[blue] + 1 ) / 2 );
+			out[3 * x + 2] = static_cast<uchar>( cell[last] );
+		}
+	}
+}
+
+void PixelConversion::bayerCell( const PixelFormat format, int& red, int& blue )
+{
+	// Green fills the other two positions
+	switch ( format )
+	{
+	case PixelFormat::BayerGB8:
+		red = 2;
+		blue = 1;
+		break;
+	case PixelFormat::BayerGR8:
+		red = 1;
+		blue = 2;
+		break;
+	case PixelFormat::BayerBG8:
+		red = 3;
+		blue = 0;
+		break;
+	default:
+		red = 0;
+		blue = 3;
+		break;
+	}
+}
@@ -0,0 +1,105 @@
+#ifndef PIXELCONVERSION_H
+#define PIXELCONVERSION_H
+
+#include "PixelFormat.h"
+#include <opencv2/core.hpp>
+
+/**
+ * @class PixelConversion
+ * @brief Turns raw frames into 8-bit colour for consumers that need it
+ *
+ * Frames travel through the pipeline in their sensor format (see
+ * PixelFormat); only a consumer that shows or analyses colour converts, and
+ * only at the resolution it needs. A Bayer frame wanted at half its size or
+ * less is demosaiced by collapsing each 2x2 cell into one pixel, which reads
+ * every raw pixel once and writes a quarter of the output of a full
+ * demosaic.
+ *
+ * For previews, resizeToColor8() goes one step further and produces the
+ * target size and colour layout in a single pass over the camera buffer.
+ */
+class PixelConversion
+{
+public:
+	/**
+	 * @enum ChannelOrder
+	 * @brief Channel order of the converted image
+	 */
+	enum class ChannelOrder
+	{
+		Bgr, ///< OpenCV order
+		Rgb	 ///< QImage::Format_RGB888 order
+	};
+
+	/**
+	 * @brief Convert a frame to 8-bit, 3-channel colour
+	 *
+	 * Mono frames are replicated to grey, Mono16 keeps its 8 most
+	 * significant bits.
+	 *
+	 * @param src Frame in format
+	 * @param format Layout of src
+	 * @param dst Receives the colour image; its allocator is kept
+	 * @param order Channel order of dst
+	 * @param targetSize Size the consumer will show the image at, empty for full resolution.
+	 *        dst is never smaller than targetSize (unless src is), but may be smaller than src.
+	 */
+	static void toColor8( const cv::Mat& src, PixelFormat format, cv::Mat& dst, ChannelOrder order,
+						  const cv::Size& targetSize = cv::Size() );
+
+	/**
+	 * @brief Downscale and convert to 8-bit, 3-channel colour in one pass
+	 *
+	 * Every output pixel is the average of the source area it covers (like
+	 * cv::INTER_AREA with whole-pixel boundaries). Bayer frames are averaged
+	 * per colour of the mosaic, so no full-size demosaic is made. Source rows
+	 * are summed with AVX2, SSE4.1 or NEON, picked at runtime, with a scalar
+	 * fallback.
+	 *
+	 * Supports Bgr8, Mono8 and the 8-bit Bayer formats when targetSize is not
+	 * larger than the frame (for Bayer: half the frame); returns false
+	 * otherwise, use toColor8() and cv::resize() then.
+	 *
+	 * @param src Frame in format
+	 * @param format Layout of src
+	 * @param dst Receives the image of targetSize; its allocator is kept
+	 * @param order Channel order of dst
+	 * @param targetSize Size of dst; aspect ratio is the caller's business
+	 * @return true if dst was written
+	 */
+	static bool resizeToColor8( const cv::Mat& src, PixelFormat format, cv::Mat& dst, ChannelOrder order,
+								const cv::Size& targetSize );
+
+	/**
+	 * @brief Check whether toColor8() reduces a frame to half size for a target size
+	 */
+	static bool usesHalfResolution( const cv::Mat& src, PixelFormat format, const cv::Size& targetSize );
+
+private:
+	/**
+	 * @brief Full resolution demosaic with OpenCV's bilinear interpolation
+	 */
+	static void demosaic( const cv::Mat& src, PixelFormat format, cv::Mat& dst, ChannelOrder order );
+
+	/**
+	 * @brief Half resolution demosaic, one output pixel per 2x2 cell
+	 */
+	static void demosaicHalf( const cv::Mat& src, PixelFormat format, cv::Mat& dst, ChannelOrder order );
+
+	/**
+	 * @brief Position of red and blue in a Bayer format's 2x2 cell, as row * 2 + column
+	 */
+	static void bayerCell( PixelFormat format, int& red, int& blue );
+
+	/**
+	 * @brief resizeToColor8() for Bgr8 and Mono8
+	 */
+	static void resizePacked( const cv::Mat& src, int channels, cv::Mat& dst, ChannelOrder order );
+
+	/**
+	 * @brief resizeToColor8() for the Bayer formats
+	 */
+	static void resizeBayer( const cv::Mat& src, PixelFormat format, cv::Mat& dst, ChannelOrder order );
+};
+
+#endif // PIXELCONVERSION_H
@@ -0,0 +1,234 @@
+#include "PreviewRenderer.h"
+#include "PixelConversion.h"
+#include <vector>
+#include <opencv2/imgproc.hpp>
+
+namespace
+{
+// Format_BGR888 arrived in Qt 5.14; older versions get RGB and pay for the swap
+#if QT_VERSION >= QT_VERSION_CHECK( 5, 14, 0 )
+constexpr PixelConversion::ChannelOrder kTileOrder = PixelConversion::ChannelOrder::Bgr;
+constexpr QImage::Format kTileFormat = QImage::Format_BGR888;
+#else
+constexpr PixelConversion::ChannelOrder kTileOrder = PixelConversion::ChannelOrder::Rgb;
+constexpr QImage::Format kTileFormat = QImage::Format_RGB888;
+#endif
+} // namespace
+
+PreviewRenderer::PreviewRenderer( WorkStealingPool& executor, QObject* parent ) : QObject( parent ), m_executor( executor )
+{
+}
+
+PreviewRenderer::~PreviewRenderer()
+{
+	std::vector<int> cameraIds;
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		m_stopping = true;
+		for ( auto& [cameraId, tile] : m_tiles )
+		{
+			tile.pending.reset();
+			cameraIds.push_back( cameraId );
+		}
+	}
+
+	for ( const int cameraId : cameraIds )
+	{
+		m_executor.waitFor( WorkStealingPool::Stage::Preview, cameraId );
+	}
+
+	std::lock_guard<std::mutex> lock( m_mutex );
+	for ( auto& [cameraId, tile] : m_tiles )
+	{
+		retirePools( tile );
+	}
+	m_tiles.clear();
+}
+
+void PreviewRenderer::render( const int cameraId, const FramePacketPtr& packet, const QSize& targetSize )
+{
+	if ( !packet )
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock( m_mutex );
+	if ( m_stopping )
+	{
+		return;
+	}
+
+	Tile& tile = m_tiles[cameraId];
+	if ( !tile.pool )
+	{
+		tile.pool = FramePool::create( kPoolBuffers );
+		tile.scratch = FramePool::create( kPoolBuffers );
+	}
+
+	if ( !tile.busy && tile.rendered && tile.last_counter == packet->frame_counter && tile.last_size == targetSize )
+	{
+		return;
+	}
+
+	tile.pending = packet;
+	tile.pending_size = targetSize;
+	if ( !tile.busy )
+	{
+		schedule( cameraId, tile );
+	}
+}
+
+void PreviewRenderer::suspend( const int cameraId )
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	const auto it = m_tiles.find( cameraId );
+	if ( it != m_tiles.end() )
+	{
+		it->second.pending.reset();
+		it->second.rendered = false;
+	}
+}
+
+void PreviewRenderer::removeCamera( const int cameraId )
+{
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		const auto it = m_tiles.find( cameraId );
+		if ( it == m_tiles.end() )
+		{
+			return;
+		}
+		it->second.pending.reset();
+	}
+
+	m_executor.waitFor( WorkStealingPool::Stage::Preview, cameraId );
+
+	std::lock_guard<std::mutex> lock( m_mutex );
+	const auto it = m_tiles.find( cameraId );
+	if ( it != m_tiles.end() )
+	{
+		retirePools( it->second );
+		m_tiles.erase( it );
+	}
+}
+
+void PreviewRenderer::schedule( const int cameraId, Tile& tile )
+{
+	tile.busy = true;
+	m_executor.submit( WorkStealingPool::Stage::Preview, cameraId, [this, cameraId] { renderNext( cameraId ); } );
+}
+
+void PreviewRenderer::renderNext( const int cameraId )
+{
+	FramePacketPtr packet;
+	QSize targetSize;
+	FramePool* pool = nullptr;
+	FramePool* scratch = nullptr;
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		const auto it = m_tiles.find( cameraId );
+		if ( it == m_tiles.end() )
+		{
+			return;
+		}
+		Tile& tile = it->second;
+		packet = std::move( tile.pending );
+		targetSize = tile.pending_size;
+		pool = tile.pool;
+		scratch = tile.scratch;
+		if ( !packet )
+		{
+			tile.busy = false;
+			return;
+		}
+	}
+
+	// The pools stay alive: removeCamera() and the destructor wait for this task before retiring them
+	const QImage image = renderTile( *packet, pool, scratch, targetSize );
+	if ( !image.isNull() )
+	{
+		emit previewReady( cameraId, image, packet->fps, packet->temperature );
+	}
+
+	std::lock_guard<std::mutex> lock( m_mutex );
+	const auto it = m_tiles.find( cameraId );
+	if ( it == m_tiles.end() )
+	{
+		return;
+	}
+	Tile& tile = it->second;
+	tile.rendered = true;
+	tile.last_counter = packet->frame_counter;
+	tile.last_size = targetSize;
+	if ( tile.pending && !m_stopping )
+	{
+		schedule( cameraId, tile );
+	}
+	else
+	{
+		tile.busy = false;
+	}
+}
+
+void PreviewRenderer::retirePools( Tile& tile )
+{
+	if ( tile.pool )
+	{
+		tile.pool->retire();
+		tile.pool = nullptr;
+	}
+	if ( tile.scratch )
+	{
+		tile.scratch->retire();
+		tile.scratch = nullptr;
+	}
+}
+
+QImage PreviewRenderer::renderTile( const FramePacket& packet, FramePool* pool, FramePool* scratch,
+									const QSize& targetSize )
+{
+	const cv::Mat& frame = packet.frame;
+	if ( frame.empty() )
+	{
+		return {};
+	}
+
+	const QSize fitted = QSize( frame.cols, frame.rows ).scaled( targetSize, Qt::KeepAspectRatio );
+	if ( fitted.isEmpty() )
+	{
+		return {};
+	}
+
+	cv::Mat tile = pool ? pool->createMat( fitted.height(), fitted.width(), CV_8UC3 )
+						: cv::Mat( fitted.height(), fitted.width(), CV_8UC3 );
+	const cv::Size tileSize( fitted.width(), fitted.height() );
+
+	// Usually one pass from the camera buffer straight to the tile. Otherwise (upscaling,
+	// Mono16) the frame is converted first, raw ones at reduced resolution where possible.
+	if ( !PixelConversion::resizeToColor8( frame, packet.pixel_format, tile, kTileOrder, tileSize ) )
+	{
+		cv::Mat color;
+		if ( packet.pixel_format == PixelFormat::Bgr8 && kTileOrder == PixelConversion::ChannelOrder::Bgr )
+		{
+			color = frame;
+		}
+		else
+		{
+			color.allocator = scratch;
+			PixelConversion::toColor8( frame, packet.pixel_format, color, kTileOrder, tileSize );
+		}
+
+		if ( color.size() == tile.size() )
+		{
+			color.copyTo( tile );
+		}
+		else
+		{
+			const int interpolation = tile.cols < color.cols ? cv::INTER_AREA : cv::INTER_LINEAR;
+			cv::resize( color, tile, tile.size(), 0, 0, interpolation );
+		}
+	}
+
+	// The image shares the tile buffer, which goes back to the pool once the GUI dropped it
+	return FramePool::wrapImage( tile, kTileFormat );
+}
@@ -0,0 +1,135 @@
+#ifndef PREVIEWRENDERER_H
+#define PREVIEWRENDERER_H
+
+#include "FramePacket.h"
+#include "FramePool.h"
+#include "WorkStealingPool.h"
+#include <QImage>
+#include <QObject>
+#include <QSize>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+/**
+ * @class PreviewRenderer
+ * @brief Turns frame packets into display-ready tile images on the executor
+ *
+ * Conversion and scaling to the tile run on the shared executor, one strand
+ * per camera. The result wraps a pooled BGR buffer (QImage::Format_BGR888,
+ * no channel swap for BGR cameras) and is handed to the GUI thread through
+ * previewReady(), together with the values of the overlay, which the view
+ * draws in its own coordinates.
+ *
+ * render() never blocks: while a camera's preview is still being rendered,
+ * only the newest packet is kept and rendered next, so a slow tile drops
+ * preview frames instead of queueing them.
+ */
+class PreviewRenderer : public QObject
+{
+	Q_OBJECT
+
+public:
+	/**
+	 * @brief Constructor
+	 * @param executor Executor running the render tasks, must outlive the renderer
+	 * @param parent Parent QObject
+	 */
+	explicit PreviewRenderer( WorkStealingPool& executor, QObject* parent = nullptr );
+
+	/**
+	 * @brief Destructor, waits for running renders and retires the pools
+	 */
+	~PreviewRenderer() override;
+
+	/**
+	 * @brief Queue a packet for rendering, replacing a packet still waiting for the camera
+	 *
+	 * A packet that was already rendered at the same size is skipped.
+	 *
+	 * @param cameraId Camera ID
+	 * @param packet Frame to show
+	 * @param targetSize Size of the tile, the image keeps the frame's aspect ratio within it
+	 */
+	void render( int cameraId, const FramePacketPtr& packet, const QSize& targetSize );
+
+	/**
+	 * @brief Stop rendering a camera whose tile cannot be seen
+	 *
+	 * Drops the packet waiting for it; the next render() of the camera renders
+	 * anew even if the packet did not change.
+	 *
+	 * @param cameraId Camera ID
+	 */
+	void suspend( int cameraId );
+
+	/**
+	 * @brief Forget a camera; waits for its running render
+	 * @param cameraId Camera ID
+	 */
+	void removeCamera( int cameraId );
+
+	/**
+	 * @brief Render one frame for a tile
+	 *
+	 * Thread-safe.
+	 *
+	 * @param packet Frame to show
+	 * @param pool Pool for the tile image (may be nullptr)
+	 * @param scratch Pool for the intermediate colour image of raw formats (may be nullptr)
+	 * @param targetSize Size of the tile
+	 * @return Tile-sized image, null if the frame is empty
+	 */
+	static QImage renderTile( const FramePacket& packet, FramePool* pool, FramePool* scratch, const QSize& targetSize );
+
+signals:
+	/**
+	 * @brief Emitted from the executor when a preview is ready
+	 * @param cameraId Camera ID
+	 * @param image Tile image
+	 * @param fps Frame rate captured with the frame
+	 * @param temperature Sensor temperature captured with the frame
+	 */
+	void previewReady( int cameraId, const QImage& image, double fps, double temperature );
+
+private:
+	/**
+	 * @struct Tile
+	 * @brief Render state of one camera
+	 */
+	struct Tile
+	{
+		FramePool* pool = nullptr;	   ///< Buffers of the tile images
+		FramePool* scratch = nullptr;  ///< Buffers of converted raw frames
+		FramePacketPtr pending;		   ///< Newest packet not yet rendered
+		QSize pending_size;			   ///< Tile size for pending
+		bool busy = false;			   ///< A render task is queued or running
+		bool rendered = false;		   ///< last_counter / last_size are valid
+		uint64_t last_counter = 0;	   ///< Frame counter of the last rendered packet
+		QSize last_size;			   ///< Tile size of the last render
+	};
+
+	/**
+	 * @brief Submit the render task of a camera (m_mutex must be held)
+	 */
+	void schedule( int cameraId, Tile& tile );
+
+	/**
+	 * @brief Render the pending packet of a camera, then schedule the next one
+	 */
+	void renderNext( int cameraId );
+
+	/**
+	 * @brief Retire the pools of a tile (m_mutex must be held)
+	 */
+	static void retirePools( Tile& tile );
+
+	static constexpr std::size_t kPoolBuffers = 4; ///< Tile images kept per camera: shown, queued, rendering, spare
+
+	WorkStealingPool& m_executor;	  ///< Runs the render tasks
+	std::mutex m_mutex;				  ///< Guards the members below
+	std::map<int, Tile> m_tiles;	  ///< Render state per camera
+	bool m_stopping = false;		  ///< Set on destruction, no new tasks
+};
+
+#endif // PREVIEWRENDERER_H
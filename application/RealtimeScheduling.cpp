@@ -0,0 +1,130 @@
+#include "RealtimeScheduling.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define MULTICAM_HAVE_POSIX_SCHED
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#endif
+
+RealtimeSchedulingConfig RealtimeScheduling::loadConfig( QSettings& settings )
+{
+	RealtimeSchedulingConfig config;
+
+	settings.beginGroup( "realtime" );
+	const QString policy = settings.value( "policy", "off" ).toString().trimmed().toLower();
+	if ( policy == "fifo" )
+	{
+		config.policy = RealtimeSchedulingConfig::Policy::Fifo;
+	}
+	else if ( policy == "rr" )
+	{
+		config.policy = RealtimeSchedulingConfig::Policy::RoundRobin;
+	}
+	config.priority = settings.value( "priority", config.priority ).toInt();
+	config.lock_memory = settings.value( "lockMemory", config.lock_memory ).toBool();
+	settings.endGroup();
+
+	return config;
+}
+
+bool RealtimeScheduling::apply( const std::thread::native_handle_type thread, const RealtimeSchedulingConfig& config,
+								QString* error )
+{
+#ifdef MULTICAM_HAVE_POSIX_SCHED
+	int policy = SCHED_OTHER;
+	switch ( config.policy )
+	{
+	case RealtimeSchedulingConfig::Policy::Off:
+		break;
+	case RealtimeSchedulingConfig::Policy::Fifo:
+		policy = SCHED_FIFO;
+		break;
+	case RealtimeSchedulingConfig::Policy::RoundRobin:
+		policy = SCHED_RR;
+		break;
+	}
+
+	sched_param param {};
+	param.sched_priority = policy == SCHED_OTHER ? 0
+												 : std::clamp( config.priority, sched_get_priority_min( policy ),
+															   sched_get_priority_max( policy ) );
+
+	const int result = pthread_setschedparam( thread, policy, &param );
+	if ( result != 0 && error )
+	{
+		*error = QString( "pthread_setschedparam failed: %1" ).arg( QString::fromLocal8Bit( std::strerror( result ) ) );
+	}
+	return result == 0;
+#else
+	Q_UNUSED( thread );
+	if ( error )
+	{
+		*error = "real-time scheduling is not supported on this platform";
+	}
+	return config.policy == RealtimeSchedulingConfig::Policy::Off;
+#endif
+}
+
+bool RealtimeScheduling::probe( const RealtimeSchedulingConfig& config, QString* error )
+{
+#ifdef MULTICAM_HAVE_POSIX_SCHED
+	// Privileges may come from root, capabilities or rlimits; trying is the only reliable check
+	bool ok = false;
+	std::thread probe( [&] { ok = apply( pthread_self(), config, error ); } );
+	probe.join();
+	return ok;
+#else
+	return apply( std::thread::native_handle_type(), config, error );
+#endif
+}
+
+bool RealtimeScheduling::lockBuffer( const void* data, const std::size_t size )
+{
+#ifdef MULTICAM_HAVE_POSIX_SCHED
+	return mlock( data, size ) == 0;
+#else
+	Q_UNUSED( data );
+	Q_UNUSED( size );
+	return false;
+#endif
+}
+
+void RealtimeScheduling::unlockBuffer( const void* data, const std::size_t size )
+{
+#ifdef MULTICAM_HAVE_POSIX_SCHED
+	munlock( data, size );
+#else
+	Q_UNUSED( data );
+	Q_UNUSED( size );
+#endif
+}
+
+long long RealtimeScheduling::memoryLockLimit()
+{
+#ifdef MULTICAM_HAVE_POSIX_SCHED
+	rlimit limit {};
+	if ( getrlimit( RLIMIT_MEMLOCK, &limit ) == 0 && limit.rlim_cur != RLIM_INFINITY )
+	{
+		return static_cast<long long>( limit.rlim_cur );
+	}
+#endif
+	return -1;
+}
+
+QString RealtimeScheduling::policyName( const RealtimeSchedulingConfig::Policy policy )
+{
+	switch ( policy )
+	{
+	case RealtimeSchedulingConfig::Policy::Off:
+		return "off";
+	case RealtimeSchedulingConfig::Policy::Fifo:
+		return "fifo";
+	case RealtimeSchedulingConfig::Policy::RoundRobin:
+		return "rr";
+	}
+	return {};
+}
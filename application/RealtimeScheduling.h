@@ -0,0 +1,73 @@
+#ifndef REALTIMESCHEDULING_H
+#define REALTIMESCHEDULING_H
+
+#include "RealtimeSchedulingConfig.h"
+#include <QSettings>
+#include <QString>
+#include <cstddef>
+#include <thread>
+
+/**
+ * @class RealtimeScheduling
+ * @brief Applies SCHED_FIFO / SCHED_RR to threads and locks buffers into RAM
+ *
+ * Real-time scheduling usually needs root, CAP_SYS_NICE or an RLIMIT_RTPRIO
+ * grant; probe() tells in advance whether the process has it. All functions
+ * fail with a reason instead of throwing, so callers can fall back to
+ * normal scheduling. Only POSIX systems are supported.
+ */
+class RealtimeScheduling
+{
+public:
+	/**
+	 * @brief Read the mode from the "realtime" settings group
+	 *
+	 * Keys: policy (off, fifo, rr), priority and lockMemory.
+	 *
+	 * @param settings Settings to read
+	 * @return Mode, Policy::Off if unset or unknown
+	 */
+	static RealtimeSchedulingConfig loadConfig( QSettings& settings );
+
+	/**
+	 * @brief Apply a scheduling mode to a thread
+	 * @param thread Native handle of the thread
+	 * @param config Mode; Policy::Off restores normal scheduling
+	 * @param error Receives the reason on failure, may be nullptr
+	 * @return true if applied
+	 */
+	static bool apply( std::thread::native_handle_type thread, const RealtimeSchedulingConfig& config,
+					   QString* error = nullptr );
+
+	/**
+	 * @brief Check whether the process may use a mode, by applying it to a short-lived thread
+	 * @param config Mode to check
+	 * @param error Receives the reason if not, may be nullptr
+	 * @return true if threads can be switched to the mode
+	 */
+	static bool probe( const RealtimeSchedulingConfig& config, QString* error = nullptr );
+
+	/**
+	 * @brief Lock a buffer into RAM
+	 * @return true if locked
+	 */
+	static bool lockBuffer( const void* data, std::size_t size );
+
+	/**
+	 * @brief Undo lockBuffer()
+	 */
+	static void unlockBuffer( const void* data, std::size_t size );
+
+	/**
+	 * @brief Get the memory lock limit of the process
+	 * @return Limit in bytes, -1 if unlimited or unknown
+	 */
+	static long long memoryLockLimit();
+
+	/**
+	 * @brief Name of a policy as used in the settings
+	 */
+	static QString policyName( RealtimeSchedulingConfig::Policy policy );
+};
+
+#endif // REALTIMESCHEDULING_H
@@ -0,0 +1,187 @@
+#include "ReplayCameraBackend.h"
+#include <QDebug>
+#include <QFileInfo>
+#include <algorithm>
+#include <fstream>
+#include <opencv2/videoio.hpp>
+
+ReplayCameraBackend::ReplayCameraBackend( const ReplayCameraConfig& config ) : m_config( config )
+{
+}
+
+bool ReplayCameraBackend::connect()
+{
+	if ( m_connected )
+	{
+		return true;
+	}
+
+	m_frames.clear();
+	m_intervals.clear();
+
+	const QString suffix = QFileInfo( m_config.path ).suffix().toLower();
+	m_raw = suffix == "raw" || suffix == "bin";
+	const bool ok = m_raw ? loadRaw() : loadVideo();
+	if ( !ok || m_frames.empty() )
+	{
+		m_frames.clear();
+		m_intervals.clear();
+		m_error_code = kErrorOpenFailed;
+		qWarning() << "[Replay] cannot load" << m_config.path;
+		return false;
+	}
+
+	qDebug() << "[Replay] decoded" << m_frames.size() << "frames of" << m_config.path;
+	m_error_code = 0;
+	m_position = 0;
+	m_delivered = 0;
+	m_connected = true;
+	return true;
+}
+
+void ReplayCameraBackend::disconnect()
+{
+	stop();
+	m_frames.clear();
+	m_frames.shrink_to_fit();
+	m_intervals.clear();
+	m_connected = false;
+}
+
+bool ReplayCameraBackend::start()
+{
+	if ( !m_connected )
+	{
+		return false;
+	}
+
+	// A replay that played to its end starts over; a stopped one resumes where it was
+	if ( m_position >= m_frames.size() )
+	{
+		m_position = 0;
+		m_delivered = 0;
+	}
+	m_running = true;
+	m_rate_window_start = Clock::now();
+	m_rate_window_frames = 0;
+	return true;
+}
+
+void ReplayCameraBackend::stop()
+{
+	m_running = false;
+	m_measured_fps = 0.0;
+}
+
+cv::Mat ReplayCameraBackend::getFrame()
+{
+	if ( !m_running || !m_power || m_frames.empty() )
+	{
+		return {};
+	}
+
+	if ( m_position >= m_frames.size() )
+	{
+		if ( !m_config.loop )
+		{
+			return {};
+		}
+		m_position = 0;
+	}
+
+	m_delivered = m_position++;
+	++m_frame_counter;
+
+	if ( isFreeRunning() )
+	{
+		++m_rate_window_frames;
+		const double window = std::chrono::duration<double>( Clock::now() - m_rate_window_start ).count();
+		if ( window >= 1.0 )
+		{
+			m_measured_fps = static_cast<double>( m_rate_window_frames ) / window;
+			m_rate_window_start = Clock::now();
+			m_rate_window_frames = 0;
+		}
+	}
+
+	return m_frames[m_delivered];
+}
+
+double ReplayCameraBackend::getFPS() const
+{
+	if ( !m_running || !m_power || m_frames.empty() )
+	{
+		return 0.0;
+	}
+
+	switch ( m_config.timing )
+	{
+	case ReplayCameraConfig::Timing::Original:
+		return 1.0 / m_intervals[m_delivered];
+	case ReplayCameraConfig::Timing::FixedRate:
+		return m_config.fps;
+	case ReplayCameraConfig::Timing::AsFastAsPossible:
+		return m_measured_fps;
+	}
+	return 0.0;
+}
+
+bool ReplayCameraBackend::loadVideo()
+{
+	cv::VideoCapture capture( m_config.path.toStdString() );
+	if ( !capture.isOpened() )
+	{
+		return false;
+	}
+
+	const double container_fps = capture.get( cv::CAP_PROP_FPS );
+	const double nominal_interval = 1.0 / ( container_fps > 0.0 ? container_fps : std::max( m_config.fps, 1.0 ) );
+
+	double previous_ms = -1.0;
+	cv::Mat frame;
+	while ( belowFrameLimit() && capture.read( frame ) )
+	{
+		// Container timestamps keep the original (possibly variable) frame spacing
+		const double position_ms = capture.get( cv::CAP_PROP_POS_MSEC );
+		if ( !m_intervals.empty() && previous_ms >= 0.0 && position_ms > previous_ms )
+		{
+			m_intervals.back() = ( position_ms - previous_ms ) / 1000.0;
+		}
+		previous_ms = position_ms;
+
+		// read() may reuse its buffer, so every frame keeps its own copy
+		m_frames.push_back( frame.clone() );
+		m_intervals.push_back( nominal_interval );
+	}
+	return true;
+}
+
+bool ReplayCameraBackend::loadRaw()
+{
+	if ( m_config.raw_width <= 0 || m_config.raw_height <= 0 )
+	{
+		qWarning() << "[Replay] raw dump needs raw_width and raw_height";
+		return false;
+	}
+
+	std::ifstream file( m_config.path.toStdString(), std::ios::binary );
+	if ( !file )
+	{
+		return false;
+	}
+
+	const double interval = 1.0 / std::max( m_config.fps, 1.0 );
+	while ( belowFrameLimit() )
+	{
+		cv::Mat frame( m_config.raw_height, m_config.raw_width, pixelFormatType( m_config.raw_format ) );
+		const auto bytes = static_cast<std::streamsize>( frame.total() * frame.elemSize() );
+		if ( !file.read( reinterpret_cast<char*>( frame.data ), bytes ) )
+		{
+			// A trailing partial frame is ignored
+			break;
+		}
+		m_frames.push_back( frame );
+		m_intervals.push_back( interval );
+	}
+	return true;
+}
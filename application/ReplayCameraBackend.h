@@ -0,0 +1,173 @@
+#ifndef REPLAYCAMERABACKEND_H
+#define REPLAYCAMERABACKEND_H
+
+#include "CameraBackend.h"
+#include "ReplayCameraConfig.h"
+#include <chrono>
+#include <vector>
+
+/**
+ * @class ReplayCameraBackend
+ * @brief CameraBackend replaying a recorded video file or raw frame dump
+ *
+ * The whole recording (up to max_frames) is decoded into memory on
+ * connect(), so decoding never shows up in measurements taken while the
+ * camera runs. Frames are handed out without copying; consumers treat
+ * frames as read-only anyway. Replay is deterministic: the same file always
+ * yields the same frames in the same order.
+ */
+class ReplayCameraBackend : public CameraBackend
+{
+public:
+	/**
+	 * @brief Constructor, does not touch the file yet
+	 * @param config Source and replay options
+	 */
+	explicit ReplayCameraBackend( const ReplayCameraConfig& config );
+
+	ReplayCameraBackend( const ReplayCameraBackend& ) = delete;
+	ReplayCameraBackend& operator=( const ReplayCameraBackend& ) = delete;
+
+	QString name() const override
+	{
+		return "Replay";
+	}
+
+	/**
+	 * @brief Decode the recording into memory
+	 * @return true if at least one frame was decoded
+	 */
+	bool connect() override;
+
+	/**
+	 * @brief Release the decoded frames
+	 */
+	void disconnect() override;
+
+	bool start() override;
+	void stop() override;
+	cv::Mat getFrame() override;
+
+	double getTemperature() const override
+	{
+		return m_config.temperature;
+	}
+
+	/**
+	 * @brief Rate until the next frame, following the configured timing
+	 */
+	double getFPS() const override;
+
+	bool isEndOfStream() const override
+	{
+		return m_running && !m_config.loop && !m_frames.empty() && m_position >= m_frames.size();
+	}
+
+	bool isFreeRunning() const override
+	{
+		return m_config.timing == ReplayCameraConfig::Timing::AsFastAsPossible;
+	}
+
+	/**
+	 * @brief raw_format for raw dumps; decoded video is BGR
+	 */
+	PixelFormat pixelFormat() const override
+	{
+		return m_raw ? m_config.raw_format : PixelFormat::Bgr8;
+	}
+
+	cv::Size frameSize() const override
+	{
+		return m_frames.empty() ? cv::Size() : m_frames.front().size();
+	}
+
+	double getExposureTime() const override
+	{
+		return m_exposure_time;
+	}
+
+	void setExposureTime( double value ) override
+	{
+		m_exposure_time = value;
+	}
+
+	double getGain() const override
+	{
+		return m_gain;
+	}
+
+	void setGain( double value ) override
+	{
+		m_gain = value;
+	}
+
+	bool getPowerStatus() const override
+	{
+		return m_power;
+	}
+
+	void setPowerStatus( bool on ) override
+	{
+		m_power = on;
+	}
+
+	uint64_t getFrameCounter() const override
+	{
+		return m_frame_counter;
+	}
+
+	int getErrorCode() const override
+	{
+		return m_error_code;
+	}
+
+	/**
+	 * @brief Get the number of frames held in memory
+	 */
+	std::size_t frameCount() const
+	{
+		return m_frames.size();
+	}
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr int kErrorOpenFailed = 1;	///< Source could not be opened or held no frame
+
+	/**
+	 * @brief Decode a video file with cv::VideoCapture
+	 */
+	bool loadVideo();
+
+	/**
+	 * @brief Split a raw dump into frames
+	 */
+	bool loadRaw();
+
+	/**
+	 * @brief Check whether more frames may be decoded
+	 */
+	bool belowFrameLimit() const
+	{
+		return m_config.max_frames == 0 || m_frames.size() < m_config.max_frames;
+	}
+
+	ReplayCameraConfig m_config;			///< Source and replay options
+	std::vector<cv::Mat> m_frames;			///< Decoded frames
+	std::vector<double> m_intervals;		///< Recorded interval after each frame in s
+	std::size_t m_position = 0;				///< Index of the next frame to deliver
+	std::size_t m_delivered = 0;			///< Index of the frame delivered last
+	bool m_connected = false;				///< Frames are decoded
+	bool m_raw = false;						///< Source is a raw dump
+	bool m_running = false;					///< Acquisition status
+	bool m_power = true;					///< Power status
+	double m_exposure_time = 0.0;			///< Stored exposure time, not applied to the footage
+	double m_gain = 1.0;					///< Stored gain, not applied to the footage
+	uint64_t m_frame_counter = 0;			///< Frames delivered
+	int m_error_code = 0;					///< Last load error
+	Clock::time_point m_rate_window_start;	///< Start of the measured rate window (free-running)
+	uint64_t m_rate_window_frames = 0;		///< Frames in the measured rate window (free-running)
+	double m_measured_fps = 0.0;			///< Delivered rate when free-running
+};
+
+#endif // REPLAYCAMERABACKEND_H
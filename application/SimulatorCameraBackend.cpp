@@ -0,0 +1,86 @@
+#include "SimulatorCameraBackend.h"
+#include "../extern/CameraSimulator/CameraSimulatorLib.h"
+
+SimulatorCameraBackend::SimulatorCameraBackend() : m_simulator( new CameraSimulatorLib )
+{
+}
+
+SimulatorCameraBackend::~SimulatorCameraBackend()
+{
+	delete m_simulator;
+}
+
+bool SimulatorCameraBackend::connect()
+{
+	return m_simulator->connect();
+}
+
+void SimulatorCameraBackend::disconnect()
+{
+	m_simulator->disconnect();
+}
+
+bool SimulatorCameraBackend::start()
+{
+	return m_simulator->start();
+}
+
+void SimulatorCameraBackend::stop()
+{
+	m_simulator->stop();
+}
+
+cv::Mat SimulatorCameraBackend::getFrame()
+{
+	return m_simulator->getFrame();
+}
+
+double SimulatorCameraBackend::getTemperature() const
+{
+	return m_simulator->getTemperature();
+}
+
+double SimulatorCameraBackend::getFPS() const
+{
+	return m_simulator->getFPS();
+}
+
+double SimulatorCameraBackend::getExposureTime() const
+{
+	return m_simulator->getExposureTime();
+}
+
+void SimulatorCameraBackend::setExposureTime( const double value )
+{
+	m_simulator->setExposureTime( value );
+}
+
+double SimulatorCameraBackend::getGain() const
+{
+	return m_simulator->getGain();
+}
+
+void SimulatorCameraBackend::setGain( const double value )
+{
+	m_simulator->setGain( value );
+}
+
+bool SimulatorCameraBackend::getPowerStatus() const
+{
+	return m_simulator->getPowerStatus();
+}
+
+void SimulatorCameraBackend::setPowerStatus( const bool on )
+{
+	m_simulator->setPowerStatus( on );
+}
+
+uint64_t SimulatorCameraBackend::getFrameCounter() const
+{
+	return m_simulator->getFrameCounter();
+}
+
+int SimulatorCameraBackend::getErrorCode() const
+{
+	return m_simulator->getErrorCode();
+}
@@ -0,0 +1,56 @@
+#ifndef SIMULATORCAMERABACKEND_H
+#define SIMULATORCAMERABACKEND_H
+
+#include "CameraBackend.h"
+
+class CameraSimulatorLib;
+
+/**
+ * @class SimulatorCameraBackend
+ * @brief CameraBackend forwarding to the vendor CameraSimulatorLib
+ *
+ * Only built when the prebuilt simulator library is available for the
+ * platform (MULTICAM_HAVE_SIMULATOR).
+ */
+class SimulatorCameraBackend : public CameraBackend
+{
+public:
+	/**
+	 * @brief Constructor, creates the simulator instance
+	 */
+	SimulatorCameraBackend();
+
+	/**
+	 * @brief Destructor, releases the simulator instance
+	 */
+	~SimulatorCameraBackend() override;
+
+	SimulatorCameraBackend( const SimulatorCameraBackend& ) = delete;
+	SimulatorCameraBackend& operator=( const SimulatorCameraBackend& ) = delete;
+
+	QString name() const override
+	{
+		return "Simulator";
+	}
+
+	bool connect() override;
+	void disconnect() override;
+	bool start() override;
+	void stop() override;
+	cv::Mat getFrame() override;
+	double getTemperature() const override;
+	double getFPS() const override;
+	double getExposureTime() const override;
+	void setExposureTime( double value ) override;
+	double getGain() const override;
+	void setGain( double value ) override;
+	bool getPowerStatus() const override;
+	void setPowerStatus( bool on ) override;
+	uint64_t getFrameCounter() const override;
+	int getErrorCode() const override;
+
+private:
+	CameraSimulatorLib* m_simulator; ///< Pointer to the simulator instance
+};
+
+#endif // SIMULATORCAMERABACKEND_H
@@ -0,0 +1,271 @@
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <QVector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class SlotMap
+ * @brief Generational slot map: stable integer handles over densely stored values
+ *
+ * Values live in one contiguous array in insertion order, so iterating all
+ * of them touches no other memory and allocates nothing. A handle combines
+ * a slot index with the slot's generation; erasing a value bumps the
+ * generation, so a handle kept past erase() no longer resolves, even after
+ * the slot is reused. The first handles of a fresh map are 0, 1, 2, ...
+ *
+ * Lookup is O(1). Erase is O(n) in the number of values to keep the
+ * insertion order, which suits registries that change rarely but are
+ * iterated every tick.
+ *
+ * @tparam T Value type
+ */
+template <typename T>
+class SlotMap
+{
+public:
+	/**
+	 * @brief Handle of a value; negative values never resolve
+	 */
+	using Handle = int;
+
+	static constexpr int kIndexBits = 16;								///< Bits of a handle addressing the slot
+	static constexpr uint32_t kIndexMask = ( 1u << kIndexBits ) - 1;	///< Slot index part of a handle
+	static constexpr uint32_t kGenerationMask = ( 1u << ( 31 - kIndexBits ) ) - 1; ///< Keeps handles positive
+
+	/**
+	 * @brief Insert a value
+	 * @param value Value to store
+	 * @return Handle of the value, -1 if all slots are in use
+	 */
+	Handle insert( T value )
+	{
+		uint32_t index;
+		if ( !m_free_slots.empty() )
+		{
+			index = m_free_slots.back();
+			m_free_slots.pop_back();
+		}
+		else
+		{
+			if ( m_slots.size() > kIndexMask )
+			{
+				return -1;
+			}
+			index = static_cast<uint32_t>( m_slots.size() );
+			m_slots.push_back( Slot() );
+		}
+
+		Slot& slot = m_slots[index];
+		slot.dense = static_cast<uint32_t>( m_values.size() );
+		slot.occupied = true;
+
+		const Handle handle = makeHandle( index, slot.generation );
+		m_values.push_back( std::move( value ) );
+		m_handles.append( handle );
+		return handle;
+	}
+
+	/**
+	 * @brief Get the handle the next insert() will return
+	 *
+	 * Lets a value know its own handle before it is inserted.
+	 *
+	 * @return Next handle, -1 if all slots are in use
+	 */
+	Handle nextHandle() const
+	{
+		if ( !m_free_slots.empty() )
+		{
+			const uint32_t index = m_free_slots.back();
+			return makeHandle( index, m_slots[index].generation );
+		}
+		return m_slots.size() > kIndexMask ? -1 : makeHandle( static_cast<uint32_t>( m_slots.size() ), 0 );
+	}
+
+	/**
+	 * @brief Remove a value; its handle becomes stale
+	 * @param handle Handle returned by insert()
+	 * @return true if the handle was valid
+	 */
+	bool erase( const Handle handle )
+	{
+		Slot* slot = slotOf( handle );
+		if ( !slot )
+		{
+			return false;
+		}
+
+		const uint32_t dense = slot->dense;
+		m_values.erase( m_values.begin() + dense );
+		m_handles.remove( static_cast<int>( dense ) );
+		for ( uint32_t i = dense; i < m_values.size(); ++i )
+		{
+			m_slots[static_cast<uint32_t>( m_handles[static_cast<int>( i )] ) & kIndexMask].dense = i;
+		}
+
+		slot->occupied = false;
+		slot->generation = ( slot->generation + 1 ) & kGenerationMask;
+		m_free_slots.push_back( static_cast<uint32_t>( handle ) & kIndexMask );
+		return true;
+	}
+
+	/**
+	 * @brief Remove all values; every handle becomes stale
+	 */
+	void clear()
+	{
+		for ( const Handle handle : m_handles )
+		{
+			Slot& slot = m_slots[static_cast<uint32_t>( handle ) & kIndexMask];
+			slot.occupied = false;
+			slot.generation = ( slot.generation + 1 ) & kGenerationMask;
+			m_free_slots.push_back( static_cast<uint32_t>( handle ) & kIndexMask );
+		}
+		m_values.clear();
+		m_handles.clear();
+	}
+
+	/**
+	 * @brief Look up a value
+	 * @param handle Handle returned by insert()
+	 * @return Pointer to the value, nullptr if the handle is stale or invalid
+	 */
+	T* find( const Handle handle )
+	{
+		const Slot* slot = slotOf( handle );
+		return slot ? &m_values[slot->dense] : nullptr;
+	}
+
+	/**
+	 * @brief Look up a value
+	 * @param handle Handle returned by insert()
+	 * @return Pointer to the value, nullptr if the handle is stale or invalid
+	 */
+	const T* find( const Handle handle ) const
+	{
+		const Slot* slot = slotOf( handle );
+		return slot ? &m_values[slot->dense] : nullptr;
+	}
+
+	/**
+	 * @brief Check whether a handle refers to a stored value
+	 */
+	bool contains( const Handle handle ) const
+	{
+		return slotOf( handle ) != nullptr;
+	}
+
+	/**
+	 * @brief Get the number of stored values
+	 */
+	int size() const
+	{
+		return static_cast<int>( m_values.size() );
+	}
+
+	/**
+	 * @brief Check whether the map is empty
+	 */
+	bool isEmpty() const
+	{
+		return m_values.empty();
+	}
+
+	/**
+	 * @brief Handles of all values, in insertion order and parallel to values()
+	 *
+	 * Implicitly shared: a copy costs no allocation until the map changes.
+	 */
+	const QVector<Handle>& handles() const
+	{
+		return m_handles;
+	}
+
+	/**
+	 * @brief Slot index of a handle
+	 *
+	 * Stays the same while the value lives and is not affected by erasing
+	 * other values; the slot goes to a later insert() once the value is erased.
+	 */
+	static int slotIndex( const Handle handle )
+	{
+		return static_cast<int>( static_cast<uint32_t>( handle ) & kIndexMask );
+	}
+
+	/**
+	 * @brief All values, contiguous and in insertion order
+	 */
+	const std::vector<T>& values() const
+	{
+		return m_values;
+	}
+
+	typename std::vector<T>::iterator begin()
+	{
+		return m_values.begin();
+	}
+
+	typename std::vector<T>::iterator end()
+	{
+		return m_values.end();
+	}
+
+	typename std::vector<T>::const_iterator begin() const
+	{
+		return m_values.begin();
+	}
+
+	typename std::vector<T>::const_iterator end() const
+	{
+		return m_values.end();
+	}
+
+private:
+	/**
+	 * @struct Slot
+	 * @brief Indirection from a handle to the dense arrays
+	 */
+	struct Slot
+	{
+		uint32_t generation = 0; ///< Bumped on every erase of the slot's value
+		uint32_t dense = 0;		 ///< Index into m_values and m_handles
+		bool occupied = false;	 ///< Slot holds a value
+	};
+
+	static Handle makeHandle( const uint32_t index, const uint32_t generation )
+	{
+		return static_cast<Handle>( ( generation << kIndexBits ) | index );
+	}
+
+	const Slot* slotOf( const Handle handle ) const
+	{
+		if ( handle < 0 )
+		{
+			return nullptr;
+		}
+		const uint32_t index = static_cast<uint32_t>( handle ) & kIndexMask;
+		const uint32_t generation = static_cast<uint32_t>( handle ) >> kIndexBits;
+		if ( index >= m_slots.size() )
+		{
+			return nullptr;
+		}
+		const Slot& slot = m_slots[index];
+		return slot.occupied && slot.generation == generation ? &slot : nullptr;
+	}
+
+	Slot* slotOf( const Handle handle )
+	{
+		return const_cast<Slot*>( static_cast<const SlotMap*>( this )->slotOf( handle ) );
+	}
+
+	std::vector<T> m_values;			 ///< Dense values
+	QVector<Handle> m_handles;			 ///< Handle of each dense value
+	std::vector<Slot> m_slots;			 ///< Slot per handle index
+	std::vector<uint32_t> m_free_slots;	 ///< Slots available for reuse
+};
+
+#endif // SLOTMAP_H
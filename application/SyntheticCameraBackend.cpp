@@ -0,0 +1,203 @@
+#include "SyntheticCameraBackend.h"
+#include "FrameReduction.h"
+#include <algorithm>
+#include <thread>
+#include <opencv2/imgproc.hpp>
+
+SyntheticCameraBackend::SyntheticCameraBackend( const SyntheticCameraConfig& config ) :
+	m_config( config ), m_frame_pool( FramePool::create() ), m_random( config.seed != 0 ? config.seed : std::random_device()() )
+{
+	m_config.width = std::max( m_config.width, 1 );
+	m_config.height = std::max( m_config.height, 1 );
+
+	renderPattern();
+	m_readout = m_pattern;
+}
+
+SyntheticCameraBackend::~SyntheticCameraBackend()
+{
+	// Frames still held downstream return their buffers later; the pool deletes itself then
+	m_frame_pool->retire();
+}
+
+bool SyntheticCameraBackend::connect()
+{
+	m_connected = true;
+	return true;
+}
+
+void SyntheticCameraBackend::disconnect()
+{
+	stop();
+	m_connected = false;
+}
+
+bool SyntheticCameraBackend::start()
+{
+	if ( !m_connected )
+	{
+		return false;
+	}
+	if ( !m_running )
+	{
+		m_running = true;
+		m_running_since = Clock::now();
+	}
+	return true;
+}
+
+void SyntheticCameraBackend::stop()
+{
+	if ( m_running )
+	{
+		m_heat_minutes = heatMinutes();
+		m_running = false;
+	}
+}
+
+cv::Mat SyntheticCameraBackend::getFrame()
+{
+	// An empty readout comes from a region of interest outside the sensor
+	if ( !m_running || !m_power || m_readout.empty() )
+	{
+		return {};
+	}
+
+	if ( m_config.jitter_ms > 0.0 )
+	{
+		std::uniform_real_distribution<double> jitter( 0.0, m_config.jitter_ms );
+		std::this_thread::sleep_for( std::chrono::duration<double, std::milli>( jitter( m_random ) ) );
+	}
+
+	// Brightness scaling and copy into the pooled buffer in one pass
+	cv::Mat frame;
+	frame.allocator = m_frame_pool;
+	const double brightness = std::clamp( m_gain * m_exposure_time / kReferenceExposureUs, 0.0, 4.0 );
+	m_readout.convertTo( frame, -1, brightness );
+
+	// Moving bar, advancing one step per frame
+	const int bar_height = std::max( frame.rows / 20, 1 );
+	const int steps = std::max( frame.rows - bar_height, 1 );
+	const int top = static_cast<int>( m_frame_counter % static_cast<uint64_t>( steps ) );
+	frame.rowRange( top, top + bar_height ).setTo( cv::Scalar::all( frame.depth() == CV_16U ? 65535 : 255 ) );
+
+	++m_frame_counter;
+	return frame;
+}
+
+void SyntheticCameraBackend::renderPattern()
+{
+	// Diagonal gradient, different per channel so colour handling errors are visible
+	cv::Mat x( 1, m_config.width, CV_32F );
+	cv::Mat y( m_config.height, 1, CV_32F );
+	for ( int i = 0; i < m_config.width; ++i )
+	{
+		x.at<float>( i ) = 160.0f * static_cast<float>( i ) / static_cast<float>( m_config.width );
+	}
+	for ( int i = 0; i < m_config.height; ++i )
+	{
+		y.at<float>( i ) = 80.0f * static_cast<float>( i ) / static_cast<float>( m_config.height );
+	}
+	cv::Mat gradient = cv::repeat( y, 1, m_config.width ) + cv::repeat( x, m_config.height, 1 );
+
+	switch ( m_config.pixel_format )
+	{
+	case PixelFormat::Mono8:
+		gradient.convertTo( m_pattern, CV_8U );
+		return;
+	case PixelFormat::Mono16:
+		gradient.convertTo( m_pattern, CV_16U, 256.0 );
+		return;
+	default:
+		break;
+	}
+
+	cv::Mat channels[3];
+	gradient.convertTo( channels[0], CV_8U, 1.0, 40.0 );
+	gradient.convertTo( channels[1], CV_8U );
+	cv::flip( channels[1], channels[2], 1 );
+	if ( !isBayer( m_config.pixel_format ) )
+	{
+		cv::merge( channels, 3, m_pattern );
+		return;
+	}
+
+	// Sample the colour gradient through the colour filter array, like a raw sensor would
+	static constexpr int kBlue = 0;
+	static constexpr int kGreen = 1;
+	static constexpr int kRed = 2;
+	int cell[4] = { kRed, kGreen, kGreen, kBlue };
+	switch ( m_config.pixel_format )
+	{
+	case PixelFormat::BayerGB8:
+		cell[0] = kGreen;
+		cell[1] = kBlue;
+		cell[2] = kRed;
+		cell[3] = kGreen;
+		break;
+	case PixelFormat::BayerGR8:
+		cell[0] = kGreen;
+		cell[1] = kRed;
+		cell[2] = kBlue;
+		cell[3] = kGreen;
+		break;
+	case PixelFormat::BayerBG8:
+		cell[0] = kBlue;
+		cell[3] = kRed;
+		break;
+	default:
+		break;
+	}
+
+	m_pattern.create( m_config.height, m_config.width, CV_8UC1 );
+	for ( int y = 0; y < m_config.height; ++y )
+	{
+		uchar* out = m_pattern.ptr<uchar>( y );
+		for ( int x = 0; x < m_config.width; ++x )
+		{
+			out[x] = channels[cell[( y % 2 ) * 2 + x % 2]].at<uchar>( y, x );
+		}
+	}
+}
+
+bool SyntheticCameraBackend::setAcquisitionSettings( const AcquisitionSettings& settings )
+{
+	// Reduced once here instead of per frame, like a sensor reading out fewer pixels
+	m_readout = FrameReduction::apply( m_pattern, m_config.pixel_format, settings ).clone();
+	return true;
+}
+
+double SyntheticCameraBackend::getTemperature() const
+{
+	return std::min( m_config.temperature + m_config.temperature_drift * heatMinutes(),
+					 std::max( m_config.temperature_max, m_config.temperature ) );
+}
+
+double SyntheticCameraBackend::getFPS() const
+{
+	return m_running && m_power ? m_config.fps : 0.0;
+}
+
+void SyntheticCameraBackend::setExposureTime( const double value )
+{
+	m_exposure_time = std::max( value, 0.0 );
+}
+
+void SyntheticCameraBackend::setGain( const double value )
+{
+	m_gain = std::max( value, 0.0 );
+}
+
+void SyntheticCameraBackend::setPowerStatus( const bool on )
+{
+	m_power = on;
+}
+
+double SyntheticCameraBackend::heatMinutes() const
+{
+	if ( !m_running )
+	{
+		return m_heat_minutes;
+	}
+	return m_heat_minutes + std::chrono::duration<double, std::ratio<60>>( Clock::now() - m_running_since ).count();
+}
@@ -0,0 +1,132 @@
+#ifndef SYNTHETICCAMERABACKEND_H
+#define SYNTHETICCAMERABACKEND_H
+
+#include "CameraBackend.h"
+#include "FramePool.h"
+#include "SyntheticCameraConfig.h"
+#include <chrono>
+#include <random>
+
+/**
+ * @class SyntheticCameraBackend
+ * @brief In-process CameraBackend generating test frames without the vendor library
+ *
+ * Frames show a static gradient with a bar moving one step per frame, so
+ * dropped or repeated frames are visible. Brightness follows exposure time
+ * and gain. Each frame is rendered in a single pass into a buffer of the
+ * backend's own FramePool, so many virtual cameras can run for throughput
+ * testing without per-frame heap allocation. FPS, jitter and temperature
+ * drift come from the SyntheticCameraConfig.
+ */
+class SyntheticCameraBackend : public CameraBackend
+{
+public:
+	static constexpr double kReferenceExposureUs = 10000.0; ///< Exposure rendered at full pattern brightness
+
+	/**
+	 * @brief Constructor
+	 * @param config Resolution, pixel format, timing and temperature model
+	 */
+	explicit SyntheticCameraBackend( const SyntheticCameraConfig& config = SyntheticCameraConfig() );
+
+	/**
+	 * @brief Destructor, retires the frame pool
+	 */
+	~SyntheticCameraBackend() override;
+
+	SyntheticCameraBackend( const SyntheticCameraBackend& ) = delete;
+	SyntheticCameraBackend& operator=( const SyntheticCameraBackend& ) = delete;
+
+	QString name() const override
+	{
+		return "Synthetic";
+	}
+
+	bool connect() override;
+	void disconnect() override;
+	bool start() override;
+	void stop() override;
+	cv::Mat getFrame() override;
+	double getTemperature() const override;
+	double getFPS() const override;
+
+	double getExposureTime() const override
+	{
+		return m_exposure_time;
+	}
+
+	void setExposureTime( double value ) override;
+
+	double getGain() const override
+	{
+		return m_gain;
+	}
+
+	void setGain( double value ) override;
+
+	bool getPowerStatus() const override
+	{
+		return m_power;
+	}
+
+	void setPowerStatus( bool on ) override;
+
+	uint64_t getFrameCounter() const override
+	{
+		return m_frame_counter;
+	}
+
+	int getErrorCode() const override
+	{
+		return 0;
+	}
+
+	PixelFormat pixelFormat() const override
+	{
+		return m_config.pixel_format;
+	}
+
+	cv::Size frameSize() const override
+	{
+		return m_pattern.size();
+	}
+
+	/**
+	 * @brief Render only the region of interest at the binned size
+	 */
+	bool setAcquisitionSettings( const AcquisitionSettings& settings ) override;
+
+	void setLockMemory( bool lock ) override
+	{
+		m_frame_pool->setLockMemory( lock );
+	}
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * @brief Render the static background in the configured pixel format into m_pattern
+	 */
+	void renderPattern();
+
+	/**
+	 * @brief Minutes of acquisition so far, driving the temperature drift
+	 */
+	double heatMinutes() const;
+
+	SyntheticCameraConfig m_config;				   ///< Frame and timing settings
+	cv::Mat m_pattern;							   ///< Static background rendered once
+	cv::Mat m_readout;							   ///< Background after region of interest and binning
+	FramePool* m_frame_pool;					   ///< Buffers of the generated frames
+	std::mt19937 m_random;						   ///< Jitter generator
+	bool m_connected = false;					   ///< Connection status
+	bool m_running = false;						   ///< Acquisition status
+	bool m_power = true;						   ///< Power status
+	double m_exposure_time = kReferenceExposureUs; ///< Exposure time in µs
+	double m_gain = 1.0;						   ///< Gain factor
+	uint64_t m_frame_counter = 0;				   ///< Frames generated
+	Clock::time_point m_running_since;			   ///< Start of the current acquisition
+	double m_heat_minutes = 0.0;				   ///< Acquisition minutes of previous runs
+};
+
+#endif // SYNTHETICCAMERABACKEND_H
@@ -0,0 +1,108 @@
+#include "TelemetrySampler.h"
+#include "Camera.h"
+#include <QSet>
+#include <algorithm>
+
+TelemetrySampler::TelemetrySampler( const int periodMs ) : m_period_ms( std::max( periodMs, 1 ) )
+{
+	m_thread = std::thread( &TelemetrySampler::samplingLoop, this );
+}
+
+TelemetrySampler::~TelemetrySampler()
+{
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		m_stopping = true;
+	}
+	m_wake.notify_all();
+
+	if ( m_thread.joinable() )
+	{
+		m_thread.join();
+	}
+}
+
+void TelemetrySampler::addCamera( Camera* camera )
+{
+	std::lock_guard<std::mutex> lock( m_mutex );
+	if ( !m_cameras.contains( camera ) )
+	{
+		m_cameras.append( camera );
+	}
+}
+
+void TelemetrySampler::removeCamera( Camera* camera )
+{
+	// A sample already in progress still uses the camera
+	std::unique_lock<std::mutex> lock( m_mutex );
+	m_cameras.removeAll( camera );
+	m_wake.wait( lock, [this, camera] { return m_sampling != camera; } );
+}
+
+void TelemetrySampler::setPeriod( const int periodMs )
+{
+	m_period_ms.store( std::max( periodMs, 1 ), std::memory_order_relaxed );
+}
+
+void TelemetrySampler::samplingLoop()
+{
+	using Clock = std::chrono::steady_clock;
+	auto next_deadline = Clock::now();
+
+	std::unique_lock<std::mutex> lock( m_mutex );
+	QSet<Camera*> missed;
+	while ( !m_stopping )
+	{
+		// Cameras that were busy last period come last, as they are waited for now
+		QVector<Camera*> cameras;
+		for ( Camera* camera : m_cameras )
+		{
+			if ( !missed.contains( camera ) )
+			{
+				cameras.append( camera );
+			}
+		}
+		for ( Camera* camera : m_cameras )
+		{
+			if ( missed.contains( camera ) )
+			{
+				cameras.append( camera );
+			}
+		}
+
+		// Sampled without m_mutex, so a blocking backend delays neither addCamera() nor removeCamera() of others
+		QSet<Camera*> busy;
+		for ( Camera* camera : cameras )
+		{
+			if ( m_stopping )
+			{
+				break;
+			}
+			if ( !m_cameras.contains( camera ) )
+			{
+				continue;
+			}
+
+			m_sampling = camera;
+			lock.unlock();
+			const bool sampled = camera->sampleParameters( missed.contains( camera ) );
+			lock.lock();
+			m_sampling = nullptr;
+			m_wake.notify_all();
+
+			if ( !sampled )
+			{
+				busy.insert( camera );
+			}
+		}
+		missed = busy;
+
+		// Keep a steady rate; after an overrun restart from now instead of sampling back to back
+		next_deadline += std::chrono::milliseconds( m_period_ms.load( std::memory_order_relaxed ) );
+		if ( const auto now = Clock::now(); next_deadline < now )
+		{
+			next_deadline = now;
+		}
+		m_wake.wait_until( lock, next_deadline, [this] { return m_stopping; } );
+	}
+}
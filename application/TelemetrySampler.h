@@ -0,0 +1,88 @@
+#ifndef TELEMETRYSAMPLER_H
+#define TELEMETRYSAMPLER_H
+
+#include <QVector>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class Camera;
+
+/**
+ * @class TelemetrySampler
+ * @brief Background thread polling the parameters of all cameras at a fixed period
+ *
+ * Reading the parameters of a camera takes several blocking simulator calls.
+ * The sampler performs them once per period and camera through
+ * Camera::sampleParameters(), which publishes an immutable snapshot. Every
+ * other reader (overlay, graphs, side panel, CSV log) gets the cached
+ * snapshot from Camera::getParameters() without touching the simulator.
+ *
+ * A camera whose backend is busy (e.g. inside a slow getFrame()) keeps its
+ * previous snapshot for one period instead of delaying the others; if it
+ * is still busy the next period, the sampler waits for it after sampling
+ * every other camera.
+ */
+class TelemetrySampler
+{
+public:
+	static constexpr int kDefaultPeriodMs = 100; ///< Default sampling period
+
+	/**
+	 * @brief Constructor, starts the sampling thread
+	 * @param periodMs Sampling period in ms
+	 */
+	explicit TelemetrySampler( int periodMs = kDefaultPeriodMs );
+
+	/**
+	 * @brief Destructor, stops and joins the sampling thread
+	 */
+	~TelemetrySampler();
+
+	TelemetrySampler( const TelemetrySampler& ) = delete;
+	TelemetrySampler& operator=( const TelemetrySampler& ) = delete;
+
+	/**
+	 * @brief Start sampling a camera
+	 * @param camera Camera to sample, must stay alive until removeCamera()
+	 */
+	void addCamera( Camera* camera );
+
+	/**
+	 * @brief Stop sampling a camera; returns once no sample of it is in progress
+	 * @param camera Camera to remove
+	 */
+	void removeCamera( Camera* camera );
+
+	/**
+	 * @brief Set the sampling period, takes effect after the current period
+	 * @param periodMs Period in ms, clamped to at least 1 ms
+	 */
+	void setPeriod( int periodMs );
+
+	/**
+	 * @brief Get the sampling period in ms
+	 */
+	int period() const
+	{
+		return m_period_ms.load( std::memory_order_relaxed );
+	}
+
+private:
+	/**
+	 * @brief Body of the sampling thread
+	 */
+	void samplingLoop();
+
+	QVector<Camera*> m_cameras;		  ///< Sampled cameras (m_mutex)
+	Camera* m_sampling = nullptr;	  ///< Camera being sampled right now (m_mutex)
+	std::mutex m_mutex;				  ///< Guards the members marked m_mutex, not held while sampling
+	std::condition_variable m_wake;	  ///< Wakes the thread on stop, removeCamera() when a sample ends
+	std::atomic<int> m_period_ms;	  ///< Sampling period
+	bool m_stopping = false;		  ///< Set on destruction (m_mutex)
+	std::thread m_thread;			  ///< Sampling thread
+};
+
+#endif // TELEMETRYSAMPLER_H
@@ -0,0 +1,289 @@
+#include "ThreadPlacement.h"
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+
+QVector<int> readAvailableCores()
+{
+	QVector<int> cores;
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO( &set );
+	if ( sched_getaffinity( 0, sizeof( set ), &set ) == 0 )
+	{
+		for ( int core = 0; core < CPU_SETSIZE; ++core )
+		{
+			if ( CPU_ISSET( core, &set ) )
+			{
+				cores.append( core );
+			}
+		}
+	}
+#endif
+	if ( cores.isEmpty() )
+	{
+		const int count = static_cast<int>( std::max( 1u, std::thread::hardware_concurrency() ) );
+		for ( int core = 0; core < count; ++core )
+		{
+			cores.append( core );
+		}
+	}
+	return cores;
+}
+
+} // namespace
+
+ThreadPlacement::ThreadPlacement( const ThreadPlacementConfig& config ) : m_config( config )
+{
+	m_available_cores = readAvailableCores();
+	for ( const int core : m_available_cores )
+	{
+		if ( !m_config.reserved_cores.contains( core ) )
+		{
+			m_usable_cores.append( core );
+		}
+	}
+	// Reserving every core would leave nothing to pin to
+	if ( m_usable_cores.isEmpty() )
+	{
+		m_usable_cores = m_available_cores;
+	}
+	readTopology();
+}
+
+ThreadPlacementConfig ThreadPlacement::loadConfig( QSettings& settings )
+{
+	ThreadPlacementConfig config;
+
+	settings.beginGroup( "threadPlacement" );
+	const QString policy = settings.value( "policy", "none" ).toString().trimmed().toLower();
+	if ( policy == "round-robin" )
+	{
+		config.policy = ThreadPlacementConfig::Policy::RoundRobin;
+	}
+	else if ( policy == "numa" )
+	{
+		config.policy = ThreadPlacementConfig::Policy::PerNumaNode;
+	}
+	else if ( policy == "explicit" )
+	{
+		config.policy = ThreadPlacementConfig::Policy::Explicit;
+	}
+
+	config.reserved_cores = parseCores( settings.value( "reserved" ).toString() );
+	for ( const QString& key : settings.childKeys() )
+	{
+		bool ok = false;
+		const int number = key.startsWith( "camera" ) ? key.mid( 6 ).toInt( &ok ) : -1;
+		if ( ok && number >= 0 )
+		{
+			config.camera_cores.insert( number, parseCores( settings.value( key ).toString() ) );
+		}
+	}
+	settings.endGroup();
+
+	return config;
+}
+
+QVector<int> ThreadPlacement::coresFor( const int cameraNumber ) const
+{
+	if ( cameraNumber < 0 )
+	{
+		return m_available_cores;
+	}
+
+	switch ( m_config.policy )
+	{
+	case ThreadPlacementConfig::Policy::None:
+		break;
+	case ThreadPlacementConfig::Policy::RoundRobin:
+		return { m_usable_cores[cameraNumber % m_usable_cores.size()] };
+	case ThreadPlacementConfig::Policy::PerNumaNode:
+		return std::next( m_nodes.begin(), cameraNumber % m_nodes.size() ).value();
+	case ThreadPlacementConfig::Policy::Explicit:
+	{
+		// Listed cores the process may not use are dropped
+		QVector<int> cores;
+		for ( const int core : m_config.camera_cores.value( cameraNumber ) )
+		{
+			if ( m_available_cores.contains( core ) )
+			{
+				cores.append( core );
+			}
+		}
+		if ( !cores.isEmpty() )
+		{
+			return cores;
+		}
+		break;
+	}
+	}
+	return m_available_cores;
+}
+
+int ThreadPlacement::numaNodeOf( const int core ) const
+{
+	for ( auto it = m_nodes.constBegin(); it != m_nodes.constEnd(); ++it )
+	{
+		if ( it.value().contains( core ) )
+		{
+			return it.key();
+		}
+	}
+	return -1;
+}
+
+QString ThreadPlacement::describe() const
+{
+	QString policy;
+	switch ( m_config.policy )
+	{
+	case ThreadPlacementConfig::Policy::None:
+		policy = "none";
+		break;
+	case ThreadPlacementConfig::Policy::RoundRobin:
+		policy = "round-robin";
+		break;
+	case ThreadPlacementConfig::Policy::PerNumaNode:
+		policy = "per NUMA node";
+		break;
+	case ThreadPlacementConfig::Policy::Explicit:
+		policy = "explicit";
+		break;
+	}
+
+	QStringList nodes;
+	for ( auto it = m_nodes.constBegin(); it != m_nodes.constEnd(); ++it )
+	{
+		nodes << QString( "node %1: %2" ).arg( it.key() ).arg( formatCores( it.value() ) );
+	}
+
+	QString text = QString( "Thread placement %1, usable cores %2 (%3)" )
+					   .arg( policy, formatCores( m_usable_cores ), nodes.join( "; " ) );
+	if ( !m_config.reserved_cores.isEmpty() )
+	{
+		text += QString( ", reserved %1" ).arg( formatCores( m_config.reserved_cores ) );
+	}
+	return text;
+}
+
+bool ThreadPlacement::pin( const std::thread::native_handle_type thread, const QVector<int>& cores, QString* error )
+{
+	if ( cores.isEmpty() )
+	{
+		if ( error )
+		{
+			*error = "empty core list";
+		}
+		return false;
+	}
+
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO( &set );
+	for ( const int core : cores )
+	{
+		if ( core >= 0 && core < CPU_SETSIZE )
+		{
+			CPU_SET( core, &set );
+		}
+	}
+
+	const int result = pthread_setaffinity_np( thread, sizeof( set ), &set );
+	if ( result != 0 && error )
+	{
+		*error = QString( "pthread_setaffinity_np failed (%1)" ).arg( result );
+	}
+	return result == 0;
+#else
+	Q_UNUSED( thread );
+	if ( error )
+	{
+		*error = "thread affinity is not supported on this platform";
+	}
+	return false;
+#endif
+}
+
+QVector<int> ThreadPlacement::parseCores( const QString& text )
+{
+	QVector<int> cores;
+	for ( const QString& part : text.split( ',', Qt::SkipEmptyParts ) )
+	{
+		const QStringList bounds = part.trimmed().split( '-' );
+		bool first_ok = false;
+		bool last_ok = false;
+		const int first = bounds.value( 0 ).toInt( &first_ok );
+		const int last = bounds.size() == 2 ? bounds[1].toInt( &last_ok ) : first;
+		if ( !first_ok || ( bounds.size() == 2 && !last_ok ) || bounds.size() > 2 || first < 0 || last < first )
+		{
+			continue;
+		}
+		for ( int core = first; core <= last; ++core )
+		{
+			cores.append( core );
+		}
+	}
+
+	std::sort( cores.begin(), cores.end() );
+	cores.erase( std::unique( cores.begin(), cores.end() ), cores.end() );
+	return cores;
+}
+
+QString ThreadPlacement::formatCores( const QVector<int>& cores )
+{
+	QStringList ranges;
+	for ( int i = 0; i < cores.size(); )
+	{
+		int j = i;
+		while ( j + 1 < cores.size() && cores[j + 1] == cores[j] + 1 )
+		{
+			++j;
+		}
+		ranges << ( i == j ? QString::number( cores[i] ) : QString( "%1-%2" ).arg( cores[i] ).arg( cores[j] ) );
+		i = j + 1;
+	}
+	return ranges.join( ',' );
+}
+
+void ThreadPlacement::readTopology()
+{
+	const QDir sysfs( "/sys/devices/system/node" );
+	for ( const QString& entry : sysfs.entryList( { "node*" }, QDir::Dirs ) )
+	{
+		bool ok = false;
+		const int node = entry.mid( 4 ).toInt( &ok );
+		QFile cpulist( sysfs.filePath( entry + "/cpulist" ) );
+		if ( !ok || !cpulist.open( QIODevice::ReadOnly ) )
+		{
+			continue;
+		}
+
+		QVector<int> cores;
+		for ( const int core : parseCores( QString::fromLatin1( cpulist.readAll() ) ) )
+		{
+			if ( m_usable_cores.contains( core ) )
+			{
+				cores.append( core );
+			}
+		}
+		if ( !cores.isEmpty() )
+		{
+			m_nodes.insert( node, cores );
+		}
+	}
+
+	if ( m_nodes.isEmpty() )
+	{
+		m_nodes.insert( 0, m_usable_cores );
+	}
+}
@@ -0,0 +1,115 @@
+#ifndef THREADPLACEMENT_H
+#define THREADPLACEMENT_H
+
+#include "ThreadPlacementConfig.h"
+#include <QMap>
+#include <QSettings>
+#include <QString>
+#include <QVector>
+#include <thread>
+
+/**
+ * @class ThreadPlacement
+ * @brief Resolves a ThreadPlacementConfig to core sets and pins threads to them
+ *
+ * The usable cores are the cores the process may run on when the object is
+ * created, minus the reserved ones. NUMA nodes are read from sysfs; where
+ * that is unavailable all cores count as node 0. Pinning is implemented
+ * with pthread_setaffinity_np and is a reported no-op on other platforms.
+ */
+class ThreadPlacement
+{
+public:
+	/**
+	 * @brief Constructor, reads the CPU topology
+	 * @param config Placement policy
+	 */
+	explicit ThreadPlacement( const ThreadPlacementConfig& config = ThreadPlacementConfig() );
+
+	/**
+	 * @brief Read a placement policy from the "threadPlacement" settings group
+	 *
+	 * Keys: policy (none, round-robin, numa, explicit), reserved (core
+	 * list) and cameraN (core list of camera number N, explicit policy).
+	 * Core lists use the Linux cpulist format, e.g. "0-3,8".
+	 *
+	 * @param settings Settings to read
+	 * @return Policy, Policy::None if unset or unknown
+	 */
+	static ThreadPlacementConfig loadConfig( QSettings& settings );
+
+	/**
+	 * @brief Get the placement policy
+	 */
+	const ThreadPlacementConfig& config() const
+	{
+		return m_config;
+	}
+
+	/**
+	 * @brief Check whether threads are to be pinned at all
+	 */
+	bool isEnabled() const
+	{
+		return m_config.policy != ThreadPlacementConfig::Policy::None;
+	}
+
+	/**
+	 * @brief Cores the threads of a camera may run on
+	 * @param cameraNumber Camera number, see ThreadPlacementConfig
+	 * @return Core list, all available cores if the camera is not pinned
+	 */
+	QVector<int> coresFor( int cameraNumber ) const;
+
+	/**
+	 * @brief Cores the process was allowed to run on at construction
+	 */
+	const QVector<int>& availableCores() const
+	{
+		return m_available_cores;
+	}
+
+	/**
+	 * @brief Get the NUMA node of a core
+	 * @return Node number, -1 if unknown
+	 */
+	int numaNodeOf( int core ) const;
+
+	/**
+	 * @brief Human readable summary of the policy and topology
+	 */
+	QString describe() const;
+
+	/**
+	 * @brief Restrict a thread to a set of cores
+	 * @param thread Native handle of the thread
+	 * @param cores Core list, must not be empty
+	 * @param error Receives the reason on failure, may be nullptr
+	 * @return true if the affinity was applied
+	 */
+	static bool pin( std::thread::native_handle_type thread, const QVector<int>& cores, QString* error = nullptr );
+
+	/**
+	 * @brief Parse a core list such as "0-3,8"
+	 * @return Sorted cores without duplicates; invalid entries are skipped
+	 */
+	static QVector<int> parseCores( const QString& text );
+
+	/**
+	 * @brief Format a core list compactly, e.g. "0-3,8"
+	 */
+	static QString formatCores( const QVector<int>& cores );
+
+private:
+	/**
+	 * @brief Read the usable cores of every NUMA node
+	 */
+	void readTopology();
+
+	ThreadPlacementConfig m_config;	  ///< Placement policy
+	QVector<int> m_available_cores;	  ///< Cores of the process affinity mask
+	QVector<int> m_usable_cores;	  ///< Available cores that are not reserved
+	QMap<int, QVector<int>> m_nodes;  ///< Usable cores per NUMA node, empty nodes omitted
+};
+
+#endif // THREADPLACEMENT_H
@@ -0,0 +1,213 @@
+#include "WorkStealingPool.h"
+#include <QDebug>
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+WorkStealingPool::WorkStealingPool( unsigned threadCount )
+{
+	if ( threadCount == 0 )
+	{
+		threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+	}
+
+	m_workers.reserve( threadCount );
+	for ( unsigned i = 0; i < threadCount; ++i )
+	{
+		m_workers.push_back( std::make_unique<Worker>() );
+	}
+	for ( std::size_t i = 0; i < m_workers.size(); ++i )
+	{
+		m_workers[i]->thread = std::thread( &WorkStealingPool::workerLoop, this, i );
+	}
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::lock_guard<std::mutex> lock( m_wake_mutex );
+		m_stopping = true;
+	}
+	m_wake.notify_all();
+
+	for ( const auto& worker : m_workers )
+	{
+		if ( worker->thread.joinable() )
+		{
+			worker->thread.join();
+		}
+	}
+}
+
+void WorkStealingPool::submit( const Stage stage, const int affinityKey, Task task )
+{
+	const std::shared_ptr<Strand> strand = strandFor( stage, affinityKey );
+
+	bool needsSchedule = false;
+	{
+		std::lock_guard<std::mutex> lock( strand->mutex );
+		strand->tasks.push_back( std::move( task ) );
+		if ( !strand->scheduled )
+		{
+			strand->scheduled = true;
+			needsSchedule = true;
+		}
+	}
+
+	if ( needsSchedule )
+	{
+		schedule( strand );
+	}
+}
+
+void WorkStealingPool::waitFor( const Stage stage, const int affinityKey )
+{
+	// A key without a strand never had tasks
+	const std::shared_ptr<Strand> strand = findStrand( stage, affinityKey );
+	if ( !strand )
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock( strand->mutex );
+	strand->idle.wait( lock, [&strand] { return !strand->scheduled && strand->tasks.empty(); } );
+}
+
+void WorkStealingPool::dropStrands( const int affinityKey )
+{
+	for ( const Stage stage : { Stage::Encoding, Stage::Preview, Stage::Analytics } )
+	{
+		waitFor( stage, affinityKey );
+
+		// Erase only a strand that is still idle; one that got new tasks meanwhile stays
+		std::lock_guard<std::mutex> lock( m_strands_mutex );
+		const auto it = m_strands.find( strandId( stage, affinityKey ) );
+		if ( it != m_strands.end() )
+		{
+			std::lock_guard<std::mutex> strandLock( it->second->mutex );
+			if ( !it->second->scheduled && it->second->tasks.empty() )
+			{
+				m_strands.erase( it );
+			}
+		}
+	}
+}
+
+std::shared_ptr<WorkStealingPool::Strand> WorkStealingPool::findStrand( const Stage stage, const int affinityKey )
+{
+	std::lock_guard<std::mutex> lock( m_strands_mutex );
+	const auto it = m_strands.find( strandId( stage, affinityKey ) );
+	return it != m_strands.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<WorkStealingPool::Strand> WorkStealingPool::strandFor( const Stage stage, const int affinityKey )
+{
+	std::lock_guard<std::mutex> lock( m_strands_mutex );
+
+	std::shared_ptr<Strand>& strand = m_strands[strandId( stage, affinityKey )];
+	if ( !strand )
+	{
+		strand = std::make_shared<Strand>();
+		strand->stage = stage;
+		strand->key = affinityKey;
+	}
+	return strand;
+}
+
+void WorkStealingPool::schedule( const std::shared_ptr<Strand>& strand )
+{
+	const std::size_t preferred = preferredWorker( strand->key );
+
+	{
+		std::lock_guard<std::mutex> lock( m_workers[preferred]->mutex );
+		m_workers[preferred]->queue.push_back( strand );
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( m_wake_mutex );
+		m_runnable.fetch_add( 1, std::memory_order_relaxed );
+	}
+	m_wake.notify_one();
+}
+
+std::shared_ptr<WorkStealingPool::Strand> WorkStealingPool::take( const std::size_t index )
+{
+	{
+		Worker& own = *m_workers[index];
+		std::lock_guard<std::mutex> lock( own.mutex );
+		if ( !own.queue.empty() )
+		{
+			std::shared_ptr<Strand> strand = std::move( own.queue.front() );
+			own.queue.pop_front();
+			m_runnable.fetch_sub( 1, std::memory_order_relaxed );
+			return strand;
+		}
+	}
+
+	// Steal from the back of the other queues, starting with the next neighbour
+	for ( std::size_t offset = 1; offset < m_workers.size(); ++offset )
+	{
+		Worker& victim = *m_workers[( index + offset ) % m_workers.size()];
+		std::lock_guard<std::mutex> lock( victim.mutex );
+		if ( !victim.queue.empty() )
+		{
+			std::shared_ptr<Strand> strand = std::move( victim.queue.back() );
+			victim.queue.pop_back();
+			m_runnable.fetch_sub( 1, std::memory_order_relaxed );
+			m_stolen.fetch_add( 1, std::memory_order_relaxed );
+			return strand;
+		}
+	}
+
+	return nullptr;
+}
+
+void WorkStealingPool::runStrand( const std::shared_ptr<Strand>& strand )
+{
+	for ( int i = 0; i < kTasksPerTurn; ++i )
+	{
+		Task task;
+		{
+			std::lock_guard<std::mutex> lock( strand->mutex );
+			if ( strand->tasks.empty() )
+			{
+				strand->scheduled = false;
+				strand->idle.notify_all();
+				return;
+			}
+			task = std::move( strand->tasks.front() );
+			strand->tasks.pop_front();
+		}
+
+		try
+		{
+			task();
+		}
+		catch ( const std::exception& e )
+		{
+			qWarning() << "[WorkStealingPool] task for key" << strand->key << "failed:" << e.what();
+		}
+	}
+
+	// Give other strands on this worker a turn; the strand stays scheduled
+	schedule( strand );
+}
+
+void WorkStealingPool::workerLoop( const std::size_t index )
+{
+	while ( true )
+	{
+		if ( std::shared_ptr<Strand> strand = take( index ) )
+		{
+			runStrand( strand );
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock( m_wake_mutex );
+		m_wake.wait( lock, [this] { return m_stopping || m_runnable.load( std::memory_order_relaxed ) > 0; } );
+		if ( m_stopping && m_runnable.load( std::memory_order_relaxed ) == 0 )
+		{
+			return;
+		}
+	}
+}
@@ -0,0 +1,199 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief Shared work-stealing executor for per-camera processing stages
+ *
+ * Tasks are submitted for a processing stage and an affinity key, normally
+ * the camera ID. Tasks with the same stage and key run one at a time and in
+ * submission order (a "strand"). Every strand of a key is queued on the
+ * worker the key maps to, so one camera's frames keep hitting the same warm
+ * core. A worker that runs out of work steals queued strands from the
+ * others, so a load spike on one camera spreads over all cores instead of
+ * piling up behind a single thread.
+ */
+class WorkStealingPool
+{
+public:
+	/**
+	 * @brief Unit of work
+	 */
+	using Task = std::function<void()>;
+
+	/**
+	 * @enum Stage
+	 * @brief Processing stage; each stage of a camera is serialized separately
+	 */
+	enum class Stage
+	{
+		Encoding,  ///< Video encoding and writing
+		Preview,   ///< Conversion, overlay and scaling for the display
+		Analytics  ///< Any further per-frame processing
+	};
+
+	/**
+	 * @brief Constructor, starts the workers
+	 * @param threadCount Number of workers, 0 for one per hardware thread
+	 */
+	explicit WorkStealingPool( unsigned threadCount = 0 );
+
+	/**
+	 * @brief Destructor, finishes queued tasks and joins the workers
+	 */
+	~WorkStealingPool();
+
+	WorkStealingPool( const WorkStealingPool& ) = delete;
+	WorkStealingPool& operator=( const WorkStealingPool& ) = delete;
+
+	/**
+	 * @brief Submit a task; tasks of the same stage and key run serially in order
+	 * @param stage Processing stage of the task
+	 * @param affinityKey Key selecting strand and preferred worker (e.g. camera ID)
+	 * @param task Task to run
+	 */
+	void submit( Stage stage, int affinityKey, Task task );
+
+	/**
+	 * @brief Block until all tasks submitted for a stage and key have finished
+	 * @param stage Processing stage
+	 * @param affinityKey Key to wait for
+	 */
+	void waitFor( Stage stage, int affinityKey );
+
+	/**
+	 * @brief Forget the strands of a key once their tasks have finished
+	 *
+	 * Blocks like waitFor() for every stage. Call when nothing is submitted
+	 * for the key any more (e.g. its camera was removed); a later submit()
+	 * starts a new strand.
+	 *
+	 * @param affinityKey Key to forget
+	 */
+	void dropStrands( int affinityKey );
+
+	/**
+	 * @brief Get the number of workers
+	 */
+	std::size_t workerCount() const
+	{
+		return m_workers.size();
+	}
+
+	/**
+	 * @brief Get the number of strands run by a worker other than their preferred one
+	 */
+	uint64_t stolenCount() const
+	{
+		return m_stolen.load( std::memory_order_relaxed );
+	}
+
+	/**
+	 * @brief Index of the worker that strands of a key are queued on
+	 * @param affinityKey Key as passed to submit()
+	 */
+	std::size_t preferredWorker( const int affinityKey ) const
+	{
+		const auto count = static_cast<long long>( m_workers.size() );
+		return static_cast<std::size_t>( ( ( affinityKey % count ) + count ) % count );
+	}
+
+	/**
+	 * @brief Native handle of a worker thread (e.g. for placement)
+	 * @param index Worker index below workerCount()
+	 */
+	std::thread::native_handle_type nativeHandle( std::size_t index )
+	{
+		return m_workers[index]->thread.native_handle();
+	}
+
+private:
+	/**
+	 * @struct Strand
+	 * @brief Serial queue of the tasks of one stage and affinity key
+	 */
+	struct Strand
+	{
+		Stage stage = Stage::Encoding;	 ///< Processing stage
+		int key = 0;					 ///< Affinity key
+		std::mutex mutex;				 ///< Guards the members below
+		std::condition_variable idle;	 ///< Signalled when the strand ran dry
+		std::deque<Task> tasks;			 ///< Pending tasks in submission order
+		bool scheduled = false;			 ///< Strand is queued on or running in a worker
+	};
+
+	/**
+	 * @struct Worker
+	 * @brief One worker thread with its own queue of runnable strands
+	 */
+	struct Worker
+	{
+		std::thread thread;						  ///< Worker thread
+		std::mutex mutex;						  ///< Guards queue
+		std::deque<std::shared_ptr<Strand>> queue; ///< Runnable strands, owner pops front, thieves pop back
+	};
+
+	static constexpr int kTasksPerTurn = 8; ///< Tasks a strand runs before yielding its worker
+
+	/**
+	 * @brief Get or create the strand of a stage and key
+	 */
+	std::shared_ptr<Strand> strandFor( Stage stage, int affinityKey );
+
+	/**
+	 * @brief Get the strand of a stage and key if it exists
+	 */
+	std::shared_ptr<Strand> findStrand( Stage stage, int affinityKey );
+
+	/**
+	 * @brief Key of a strand in m_strands
+	 */
+	static uint64_t strandId( Stage stage, int affinityKey )
+	{
+		return ( static_cast<uint64_t>( stage ) << 32 ) | static_cast<uint32_t>( affinityKey );
+	}
+
+	/**
+	 * @brief Queue a strand on the worker its key maps to and wake a worker
+	 */
+	void schedule( const std::shared_ptr<Strand>& strand );
+
+	/**
+	 * @brief Take a runnable strand, own queue first, then steal
+	 * @param index Index of the calling worker
+	 */
+	std::shared_ptr<Strand> take( std::size_t index );
+
+	/**
+	 * @brief Run up to kTasksPerTurn tasks of a strand, requeue it if more remain
+	 */
+	void runStrand( const std::shared_ptr<Strand>& strand );
+
+	/**
+	 * @brief Body of a worker thread
+	 */
+	void workerLoop( std::size_t index );
+
+	std::vector<std::unique_ptr<Worker>> m_workers;					   ///< Worker threads
+	std::mutex m_strands_mutex;										   ///< Guards m_strands
+	std::unordered_map<uint64_t, std::shared_ptr<Strand>> m_strands;   ///< Strand per stage and affinity key
+	std::mutex m_wake_mutex;										   ///< Guards sleeping
+	std::condition_variable m_wake;									   ///< Wakes idle workers
+	std::atomic<std::size_t> m_runnable { 0 };						   ///< Strands queued in any worker
+	std::atomic<uint64_t> m_stolen { 0 };							   ///< Strands run by a thief
+	bool m_stopping = false;										   ///< Set on destruction (m_wake_mutex)
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -1,5 +1,7 @@
 #include "videosaver.h"
 #include <stdexcept>
+#include <algorithm>
+#include <cmath>
 #include <QDir>
 #include <QDebug>
 
@@ -7,6 +9,7 @@ VideoSaver::VideoSaver(QObject *parent) : QObject(parent) {}
 
 void VideoSaver::configureCameras(const QList<int> &cameraIds)
 {
+    // the caller makes sure no write is pending, they reference the streams replaced here
     m_streams.clear();
     for (int id : cameraIds)
     {
@@ -48,6 +51,8 @@ void VideoSaver::startRecording(const QString &outputDir, double fps, VideoForma
     for (auto &[id, stream] : m_streams)
     {
         stream.writerInitialized = false;
+        stream.hasWrittenFrame = false;
+        stream.openFailed = false;
     }
 
     qDebug() << "Recording Started";
@@ -65,71 +70,165 @@ void VideoSaver::stopRecording()
         {
             stream.writer.release();
         }
+        if (stream.rawFile.is_open())
+        {
+            stream.rawFile.close();
+        }
         stream.writerInitialized = false;
+        stream.previousFrame.release();
     }
 
     m_isRecording = false;
     qDebug() << "Recording Stopped";
 }
 
-void VideoSaver::onNewFrame(int cameraId, const cv::Mat &frame)
+void VideoSaver::onNewFrame(const FramePacketPtr &packet)
 {
-    if (!m_isRecording)
+    if (!m_isRecording || !packet)
         return;
 
-    auto it = m_streams.find(cameraId);
+    auto it = m_streams.find(packet->camera_id);
     if (it == m_streams.end())
         return;
 
-    CameraStream &stream = it->second;
+    writeFrame(it->second, packet);
+}
 
-    if (!stream.writerInitialized)
-    {
-        stream.frameSize = cv::Size(frame.cols, frame.rows);
+void VideoSaver::writeFrame(CameraStream &stream, const FramePacketPtr &packet)
+{
+    const cv::Mat &frame = packet->frame;
 
-        QDir dir(m_outputDir);
+    // same frame delivered twice -> already in the file
+    if (stream.hasWrittenFrame && stream.lastFrameCounter == packet->frame_counter)
+        return;
 
-        // file path : <outputDir>/camera_<id>.<extension>
-        QString fileExtension = (m_format == VideoFormat::MP4) ? "mp4" : "avi";
-        QString fileName = QString("camera_%1.%2").arg(cameraId).arg(fileExtension);
-        QString fullPath = dir.filePath(fileName);
+    // a stream that cannot be opened is skipped until the next recording instead of retried per frame
+    if (stream.openFailed)
+        return;
 
-        // OpenCV needs std::string
-        std::string pathStd = fullPath.toStdString();
+    if (!stream.writerInitialized)
+    {
+        try
+        {
+            openStream(stream, packet);
+        }
+        catch (const std::exception &e)
+        {
+            stream.openFailed = true;
+            qWarning() << "[VideoSaver]" << e.what() << "- camera is not recorded";
+            return;
+        }
+    }
 
-        // Choose codec based on format
-        int fourcc;
-        if (m_format == VideoFormat::MP4)
+    // Frames hineinschreiben
+    if (stream.rawFile.is_open())
+    {
+        // raw formats are stored untouched, row by row in case the frame is a padded view
+        const std::size_t rowBytes = frame.cols * frame.elemSize();
+        for (int y = 0; y < frame.rows; ++y)
         {
-            // Try H.264 codec for MP4 (most compatible)
-            fourcc = cv::VideoWriter::fourcc('H', '2', '6', '4');
-            // Alternative: cv::VideoWriter::fourcc('a', 'v', 'c', '1') or
-            // cv::VideoWriter::fourcc('X', '2', '6', '4')
+            stream.rawFile.write(reinterpret_cast<const char *>(frame.ptr(y)), static_cast<std::streamsize>(rowBytes));
+        }
+    }
+    else
+    {
+        // The previous frame is repeated until this one reaches its slot on the capture time line,
+        // so frames dropped by backpressure do not speed up playback
+        if (stream.videoFrames == 0)
+        {
+            stream.firstTimestampNs = packet->timestamp_ns;
         }
         else
         {
-            fourcc = cv::VideoWriter::fourcc('M', 'J', 'P', 'G'); // MJPEG codec for AVI
+            const double elapsed = (packet->timestamp_ns - stream.firstTimestampNs) * 1e-9;
+            const int64_t slot = std::llround(elapsed * stream.fps);
+            const int64_t missing = slot - static_cast<int64_t>(stream.videoFrames);
+            const int64_t maxFill = static_cast<int64_t>(std::ceil(stream.fps));
+            for (int64_t i = 0; i < std::min(missing, maxFill); ++i)
+            {
+                stream.writer.write(stream.previousFrame);
+            }
+            stream.videoFrames += static_cast<uint64_t>(std::clamp<int64_t>(missing, 0, maxFill));
+
+            // a longer outage is cut to one second: move the time line so this frame is next
+            if (missing > maxFill)
+            {
+                stream.firstTimestampNs = packet->timestamp_ns - std::llround(stream.videoFrames * 1e9 / stream.fps);
+            }
         }
+        stream.writer.write(frame);
+        stream.previousFrame = frame;
+        ++stream.videoFrames;
+    }
+    stream.hasWrittenFrame = true;
+    stream.lastFrameCounter = packet->frame_counter;
+}
+
+void VideoSaver::openStream(CameraStream &stream, const FramePacketPtr &packet)
+{
+    const int cameraId = packet->camera_id;
+    const cv::Mat &frame = packet->frame;
+    stream.frameSize = cv::Size(frame.cols, frame.rows);
 
-        double fps = m_fps;
-        // double fps = 33;
-        bool ok = stream.writer.open(
-            pathStd,
-            fourcc,
-            fps,
-            stream.frameSize,
-            frame.channels() == 3 // Farbvideo oder nicht
-        );
-
-        if (!ok)
+    QDir dir(m_outputDir);
+
+    // Bayer mosaics would be ruined by lossy codecs, 16 bit does not fit them at all
+    if (isBayer(packet->pixel_format) || packet->pixel_format == PixelFormat::Mono16)
+    {
+        // file path : <outputDir>/camera_<id>_<width>x<height>_<format>.raw
+        const QString fileName = QString("camera_%1_%2x%3_%4.raw")
+            .arg(cameraId).arg(frame.cols).arg(frame.rows).arg(pixelFormatName(packet->pixel_format));
+        stream.rawFile.open(dir.filePath(fileName).toStdString(), std::ios::binary | std::ios::trunc);
+        if (!stream.rawFile.is_open())
         {
             throw std::runtime_error(
-                "Failed to open VideoWriter for camera " + std::to_string(cameraId));
+                "Failed to open raw file for camera " + std::to_string(cameraId));
         }
-
         stream.writerInitialized = true;
+        return;
     }
 
-    // Frames hineinschreiben
-    stream.writer.write(frame);
+    // file path : <outputDir>/camera_<id>.<extension>
+    QString fileExtension = (m_format == VideoFormat::MP4) ? "mp4" : "avi";
+    QString fileName = QString("camera_%1.%2").arg(cameraId).arg(fileExtension);
+    QString fullPath = dir.filePath(fileName);
+
+    // OpenCV needs std::string
+    std::string pathStd = fullPath.toStdString();
+
+    // Choose codec based on format
+    int fourcc;
+    if (m_format == VideoFormat::MP4)
+    {
+        // Try H.264 codec for MP4 (most compatible)
+        fourcc = cv::VideoWriter::fourcc('H', '2', '6', '4');
+        // Alternative: cv::VideoWriter::fourcc('a', 'v', 'c', '1') or
+        // cv::VideoWriter::fourcc('X', '2', '6', '4')
+    }
+    else
+    {
+        fourcc = cv::VideoWriter::fourcc('M', 'J', 'P', 'G'); // MJPEG codec for AVI
+    }
+
+    // each camera is recorded at the rate its frames are published at, independent of
+    // dispatch and display; decimated streams are slower than the camera
+    const double fps = packet->stream_fps > 0.0 ? packet->stream_fps : m_fps;
+    stream.fps = fps;
+    stream.videoFrames = 0;
+    stream.previousFrame.release();
+    bool ok = stream.writer.open(
+        pathStd,
+        fourcc,
+        fps,
+        stream.frameSize,
+        packet->pixel_format == PixelFormat::Bgr8 // Farbvideo oder nicht
+    );
+
+    if (!ok)
+    {
+        throw std::runtime_error(
+            "Failed to open VideoWriter for camera " + std::to_string(cameraId));
+    }
+
+    stream.writerInitialized = true;
 }
@@ -4,6 +4,8 @@
 #include <QObject>
 #include <opencv2/opencv.hpp>
 #include <map>
+#include <fstream>
+#include "FramePacket.h"
 
 enum class VideoFormat
 {
@@ -32,28 +34,53 @@ public:
 
     /// @brief starts all recordings and opens one file per cam
     /// @param outputDir dir to save the files to
-    /// @param fps for recordings
+    /// @param fps for recordings of cameras whose frames carry no frame rate;
+    ///        otherwise each file is written at its stream's rate (after decimation)
     /// @param format video format (AVI or MP4)
     void startRecording(const QString &outputDir, double fps, VideoFormat format = VideoFormat::AVI);
 
     /// @brief stops all recordings and closes files
     void stopRecording();
 
-    /// @brief takes new frame from CamManager and writes it into VideoWriter
-    /// @param cameraId id of Cam the current frame came from
-    /// @param current frame
-    void onNewFrame(int cameraId, const cv::Mat &frame);
+    /// @brief takes new frame packet from CamManager and writes it into VideoWriter;
+    ///        Bayer and Mono16 frames are not debayered or reduced but appended
+    ///        unchanged to camera_<id>_<width>x<height>_<format>.raw (replayable
+    ///        with ReplayCameraBackend), Mono8 is written as greyscale video
+    ///        (blocking; CamManager calls it from its queued encoding consumer,
+    ///        serialized per camera)
+    /// @param packet current frame with its camera id and frame counter; a packet
+    ///        whose frame counter was already written for that camera is skipped.
+    ///        Frames lost before the saver (backpressure) are filled in by repeating
+    ///        the previous frame per capture timestamps, so videos keep real-time speed;
+    ///        of a longer outage only one second is filled, the rest is cut
+    void onNewFrame(const FramePacketPtr &packet);
 
     /// @brief true if recording
     bool isRecording() const { return m_isRecording; }
 
 private:
+    struct CameraStream;
+
+    /// @brief opens the writer on the first frame and writes the packet
+    void writeFrame(CameraStream &stream, const FramePacketPtr &packet);
+
+    /// @brief opens the output of a stream matching the first frame's format
+    void openStream(CameraStream &stream, const FramePacketPtr &packet);
+
     struct CameraStream
     {
         int cameraId;
         cv::VideoWriter writer;
+        std::ofstream rawFile; ///< output for raw formats instead of writer
         bool writerInitialized = false;
+        bool openFailed = false;        ///< output could not be opened, skipped until the next recording
         cv::Size frameSize;
+        bool hasWrittenFrame = false;
+        uint64_t lastFrameCounter = 0;
+        double fps = 0.0;               ///< rate the video file was opened at
+        int64_t firstTimestampNs = 0;   ///< capture time of the first written frame
+        uint64_t videoFrames = 0;       ///< frames written to the video, repeats included
+        cv::Mat previousFrame;          ///< last frame written, repeated to fill gaps
     };
 
     std::map<int, CameraStream> m_streams;
@@ -0,0 +1,135 @@
+#include "PixelConversion.h"
+#include <QGuiApplication>
+#include <QImage>
+#include <QPixmap>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <opencv2/core.hpp>
+
+/**
+ * Compares the two ways a preview tile can be made from a camera frame:
+ *
+ * - fused: PixelConversion::resizeToColor8(), one pass from the camera buffer to the tile
+ * - legacy: cvtColor (full-resolution demosaic for Bayer) into RGB, wrapped in a QImage,
+ *   converted with QPixmap::fromImage() and scaled with Qt::SmoothTransformation,
+ *   as the GUI thread did before previews were rendered off it
+ *
+ * Frames are random noise in every synthetic format the fused path supports.
+ * Runs on the offscreen platform unless QT_QPA_PLATFORM says otherwise.
+ * Usage: PreviewConversionBenchmark [iterations]
+ */
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Resolution
+{
+	const char* name;
+	cv::Size frame;
+	cv::Size tile;
+};
+
+struct Format
+{
+	const char* name;
+	PixelFormat format;
+};
+
+/**
+ * @brief Median run time of a conversion in milliseconds
+ */
+template <typename Conversion> double medianMs( const int iterations, Conversion&& convert )
+{
+	// One untimed run to allocate the outputs and warm the caches
+	convert();
+
+	std::vector<double> times;
+	times.reserve( iterations );
+	for ( int i = 0; i < iterations; ++i )
+	{
+		const auto start = Clock::now();
+		convert();
+		times.push_back( std::chrono::duration<double, std::milli>( Clock::now() - start ).count() );
+	}
+
+	std::nth_element( times.begin(), times.begin() + times.size() / 2, times.end() );
+	return times[times.size() / 2];
+}
+
+QPixmap legacyTile( const cv::Mat& frame, const PixelFormat format, cv::Mat& rgb, const QSize& tileSize )
+{
+	// Without a target size toColor8() is a plain cvtColor of the whole frame
+	PixelConversion::toColor8( frame, format, rgb, PixelConversion::ChannelOrder::Rgb );
+	const QImage image( rgb.data, rgb.cols, rgb.rows, static_cast<int>( rgb.step ), QImage::Format_RGB888 );
+	return QPixmap::fromImage( image ).scaled( tileSize, Qt::KeepAspectRatio, Qt::SmoothTransformation );
+}
+} // namespace
+
+int main( int argc, char* argv[] )
+{
+	// QPixmap needs a GUI application, not a display
+	if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+	{
+		qputenv( "QT_QPA_PLATFORM", "offscreen" );
+	}
+	QGuiApplication application( argc, argv );
+
+	const int iterations = argc > 1 ? std::max( std::atoi( argv[1] ), 1 ) : 50;
+
+	const Resolution resolutions[] = {
+		{ "1080p", cv::Size( 1920, 1080 ), cv::Size( 480, 270 ) },
+		{ "4K", cv::Size( 3840, 2160 ), cv::Size( 480, 270 ) },
+		{ "4K", cv::Size( 3840, 2160 ), cv::Size( 960, 540 ) },
+	};
+	const Format formats[] = {
+		{ "Bgr8", PixelFormat::Bgr8 },
+		{ "Mono8", PixelFormat::Mono8 },
+		{ "BayerRG8", PixelFormat::BayerRG8 },
+		{ "BayerBG8", PixelFormat::BayerBG8 },
+	};
+
+	std::printf( "%d iterations, median per frame\n", iterations );
+	std::printf( "%-6s %-10s %-9s %12s %12s %9s\n", "frame", "format", "tile", "fused [ms]", "legacy [ms]", "speedup" );
+
+	cv::RNG rng( 42 );
+	for ( const Resolution& resolution : resolutions )
+	{
+		for ( const Format& format : formats )
+		{
+			cv::Mat frame( resolution.frame, pixelFormatType( format.format ) );
+			rng.fill( frame, cv::RNG::UNIFORM, 0, 256 );
+
+			cv::Mat tile;
+			const bool fused = PixelConversion::resizeToColor8( frame, format.format, tile,
+																PixelConversion::ChannelOrder::Rgb, resolution.tile );
+			const auto fusedTile = [&] {
+				PixelConversion::resizeToColor8( frame, format.format, tile, PixelConversion::ChannelOrder::Rgb,
+												 resolution.tile );
+			};
+			const double fusedMs = fused ? medianMs( iterations, fusedTile ) : 0.0;
+
+			cv::Mat rgb;
+			const QSize tileSize( resolution.tile.width, resolution.tile.height );
+			QPixmap pixmap;
+			const double legacyMs = medianMs( iterations, [&] { pixmap = legacyTile( frame, format.format, rgb, tileSize ); } );
+
+			const QString tileName = QStringLiteral( "%1x%2" ).arg( resolution.tile.width ).arg( resolution.tile.height );
+			if ( fused )
+			{
+				std::printf( "%-6s %-10s %-9s %12.2f %12.2f %8.1fx\n", resolution.name, format.name,
+							 qPrintable( tileName ), fusedMs, legacyMs, legacyMs / fusedMs );
+			}
+			else
+			{
+				std::printf( "%-6s %-10s %-9s %12s %12.2f %9s\n", resolution.name, format.name, qPrintable( tileName ),
+							 "n/a", legacyMs, "-" );
+			}
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,46 @@
+#ifndef ACQUISITIONSETTINGS_H
+#define ACQUISITIONSETTINGS_H
+
+#include <opencv2/core/types.hpp>
+
+/**
+ * @struct AcquisitionSettings
+ * @brief Reduction of a camera's frames: region of interest, binning and decimation
+ *
+ * Set on a Camera, it applies to every frame right at acquisition (in the
+ * backend where supported). Given to a frame consumer, it produces that
+ * consumer's own variant of the frames without affecting the others.
+ */
+struct AcquisitionSettings
+{
+	cv::Rect roi;	///< Region of interest in pixels of the frame, empty for the whole frame
+	int binning;	///< Pixels combined per axis: 1 (off), 2 or 4
+	int decimation; ///< Keep every n-th frame, 1 for all
+
+	/**
+	 * @brief Default constructor: full frames, no reduction
+	 */
+	AcquisitionSettings() : binning( 1 ), decimation( 1 )
+	{
+	}
+
+	/**
+	 * @brief Check whether the settings reduce the pixels of a frame
+	 */
+	bool reducesPixels() const
+	{
+		return !roi.empty() || binning > 1;
+	}
+
+	bool operator==( const AcquisitionSettings& other ) const
+	{
+		return roi == other.roi && binning == other.binning && decimation == other.decimation;
+	}
+
+	bool operator!=( const AcquisitionSettings& other ) const
+	{
+		return !( *this == other );
+	}
+};
+
+#endif // ACQUISITIONSETTINGS_H
@@ -0,0 +1,31 @@
+#ifndef CAMERASTARTUPREPORT_H
+#define CAMERASTARTUPREPORT_H
+
+#include <QMetaType>
+#include <QString>
+
+/**
+ * @struct CameraStartupReport
+ * @brief Result and timing of bringing up a single camera
+ */
+struct CameraStartupReport
+{
+	int camera_id;				///< Camera the report belongs to
+	bool connected;				///< Connection succeeded
+	bool started;				///< Acquisition started (only if requested)
+	double connect_ms;			///< Time from bring-up begin until connect() returned
+	double first_frame_ms;		///< Time from bring-up begin until the first frame (-1 if none)
+	QString error;				///< Failure description, empty on success
+
+	/**
+	 * @brief Default constructor initializing all fields
+	 */
+	CameraStartupReport() :
+		camera_id( -1 ), connected( false ), started( false ), connect_ms( 0.0 ), first_frame_ms( -1.0 )
+	{
+	}
+};
+
+Q_DECLARE_METATYPE( CameraStartupReport )
+
+#endif // CAMERASTARTUPREPORT_H
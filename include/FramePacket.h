@@ -0,0 +1,45 @@
+#ifndef FRAMEPACKET_H
+#define FRAMEPACKET_H
+
+#include "PixelFormat.h"
+#include <cstdint>
+#include <memory>
+#include <opencv2/core.hpp>
+
+/**
+ * @struct FramePacket
+ * @brief A captured frame together with the metadata in effect at capture
+ *
+ * Produced once per frame by the acquisition thread of a Camera and passed
+ * through the pipeline by handle (FramePacketPtr), so consumers can identify,
+ * correlate and dedupe frames without querying the camera again.
+ */
+struct FramePacket
+{
+	cv::Mat frame;				///< Frame data (shared, reference counted), raw as captured
+	PixelFormat pixel_format;	///< Layout of frame
+	int camera_id;				///< Camera that captured the frame
+	uint64_t frame_counter;		///< Camera frame counter at capture
+	int64_t timestamp_ns;		///< Host monotonic capture time in ns
+	double exposureTime;		///< Exposure time in µs at capture
+	double gain;				///< Gain factor at capture
+	double fps;					///< Camera frame rate, as last sampled by the TelemetrySampler
+	double stream_fps;			///< Rate packets of this stream are published at: fps after decimation
+	double temperature;			///< Camera temperature in °C, as last sampled by the TelemetrySampler
+
+	/**
+	 * @brief Default constructor initializing all metadata
+	 */
+	FramePacket() :
+		pixel_format( PixelFormat::Bgr8 ), camera_id( -1 ), frame_counter( 0 ), timestamp_ns( 0 ), exposureTime( 0.0 ), gain( 0.0 ), fps( 0.0 ),
+		stream_fps( 0.0 ), temperature( 0.0 )
+	{
+	}
+};
+
+/**
+ * @brief Shared, immutable handle to a FramePacket
+ */
+using FramePacketPtr = std::shared_ptr<const FramePacket>;
+
+#endif // FRAMEPACKET_H
@@ -0,0 +1,26 @@
+#ifndef FRAMESTATISTICS_H
+#define FRAMESTATISTICS_H
+
+#include <cstdint>
+
+/**
+ * @struct FrameStatistics
+ * @brief Delivery counters of one camera, derived from the backend frame counter
+ */
+struct FrameStatistics
+{
+	uint64_t delivered;		  ///< Frames published to consumers
+	uint64_t dropped;		  ///< Frames the backend counted but never handed out
+	uint64_t duplicated;	  ///< Frames handed out again with an unchanged counter, not published
+	uint64_t gaps;			  ///< Occurrences of one or more consecutive dropped frames
+	uint64_t dispatch_dropped; ///< Published frames overwritten before they could be dispatched
+
+	/**
+	 * @brief Default constructor initializing all counters
+	 */
+	FrameStatistics() : delivered( 0 ), dropped( 0 ), duplicated( 0 ), gaps( 0 ), dispatch_dropped( 0 )
+	{
+	}
+};
+
+#endif // FRAMESTATISTICS_H
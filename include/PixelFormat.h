@@ -0,0 +1,75 @@
+#ifndef PIXELFORMAT_H
+#define PIXELFORMAT_H
+
+#include <opencv2/core/hal/interface.h>
+
+/**
+ * @enum PixelFormat
+ * @brief Layout of the pixels of a frame as delivered by the sensor
+ *
+ * Bayer formats are named by the colours of the top-left 2x2 cell, read row
+ * by row (BayerRG8: R G / G B), as in GenICam. Raw formats stay raw through
+ * the pipeline; see PixelConversion for turning them into colour.
+ */
+enum class PixelFormat
+{
+	Bgr8,	  ///< 3 channels, 8 bit, blue-green-red
+	Mono8,	  ///< 1 channel, 8 bit
+	Mono16,	  ///< 1 channel, 16 bit
+	BayerRG8, ///< Colour filter array R G / G B, 8 bit
+	BayerGB8, ///< Colour filter array G B / R G, 8 bit
+	BayerGR8, ///< Colour filter array G R / B G, 8 bit
+	BayerBG8  ///< Colour filter array B G / G R, 8 bit
+};
+
+/**
+ * @brief OpenCV pixel type of frames in a format
+ */
+inline int pixelFormatType( const PixelFormat format )
+{
+	switch ( format )
+	{
+	case PixelFormat::Bgr8:
+		return CV_8UC3;
+	case PixelFormat::Mono16:
+		return CV_16UC1;
+	default:
+		return CV_8UC1;
+	}
+}
+
+/**
+ * @brief Check whether a format is a colour filter array that needs demosaicing
+ */
+inline bool isBayer( const PixelFormat format )
+{
+	return format == PixelFormat::BayerRG8 || format == PixelFormat::BayerGB8 || format == PixelFormat::BayerGR8 ||
+		   format == PixelFormat::BayerBG8;
+}
+
+/**
+ * @brief GenICam-style name of a format, e.g. "BayerRG8"
+ */
+inline const char* pixelFormatName( const PixelFormat format )
+{
+	switch ( format )
+	{
+	case PixelFormat::Bgr8:
+		return "BGR8";
+	case PixelFormat::Mono8:
+		return "Mono8";
+	case PixelFormat::Mono16:
+		return "Mono16";
+	case PixelFormat::BayerRG8:
+		return "BayerRG8";
+	case PixelFormat::BayerGB8:
+		return "BayerGB8";
+	case PixelFormat::BayerGR8:
+		return "BayerGR8";
+	case PixelFormat::BayerBG8:
+		return "BayerBG8";
+	}
+	return "";
+}
+
+#endif // PIXELFORMAT_H
@@ -0,0 +1,33 @@
+#ifndef REALTIMESCHEDULINGCONFIG_H
+#define REALTIMESCHEDULINGCONFIG_H
+
+/**
+ * @struct RealtimeSchedulingConfig
+ * @brief Real-time scheduling of the acquisition threads
+ */
+struct RealtimeSchedulingConfig
+{
+	/**
+	 * @enum Policy
+	 * @brief POSIX scheduling policy
+	 */
+	enum class Policy
+	{
+		Off,	   ///< Normal time-sharing scheduling
+		Fifo,	   ///< SCHED_FIFO: runs until it blocks or a higher priority thread is runnable
+		RoundRobin ///< SCHED_RR: like Fifo, but time-sliced among threads of equal priority
+	};
+
+	Policy policy;	  ///< Scheduling policy
+	int priority;	  ///< Real-time priority, clamped to the range of the policy
+	bool lock_memory; ///< Lock the camera frame pools into RAM
+
+	/**
+	 * @brief Default constructor: real-time mode off
+	 */
+	RealtimeSchedulingConfig() : policy( Policy::Off ), priority( 10 ), lock_memory( true )
+	{
+	}
+};
+
+#endif // REALTIMESCHEDULINGCONFIG_H
@@ -0,0 +1,50 @@
+#ifndef REPLAYCAMERACONFIG_H
+#define REPLAYCAMERACONFIG_H
+
+#include "PixelFormat.h"
+#include <QString>
+#include <cstddef>
+
+/**
+ * @struct ReplayCameraConfig
+ * @brief Settings of a camera replaying recorded footage
+ *
+ * The source is either a video file readable by OpenCV (AVI, MP4, ...) or a
+ * raw dump: a file of back-to-back frames of raw_width x raw_height pixels in
+ * raw_format, without any header, as written by VideoSaver for raw formats.
+ * Raw dumps are recognised by the extensions .raw and .bin.
+ */
+struct ReplayCameraConfig
+{
+	/**
+	 * @enum Timing
+	 * @brief How fast the recorded frames are delivered
+	 */
+	enum class Timing
+	{
+		Original,		  ///< Intervals of the recording (video timestamps, or its frame rate)
+		FixedRate,		  ///< Constant rate given by fps
+		AsFastAsPossible  ///< No pacing, limited only by the consumers
+	};
+
+	QString path;			 ///< Video file or raw frame dump
+	Timing timing;			 ///< Replay pacing
+	double fps;				 ///< Rate for Timing::FixedRate, and for raw dumps with Timing::Original
+	bool loop;				 ///< Restart at the first frame after the last one
+	std::size_t max_frames;	 ///< Frames decoded into memory, 0 for all
+	int raw_width;			 ///< Frame width of a raw dump in pixels
+	int raw_height;			 ///< Frame height of a raw dump in pixels
+	PixelFormat raw_format;	 ///< Pixel format of a raw dump
+	double temperature;		 ///< Temperature reported for the replayed camera in °C
+
+	/**
+	 * @brief Default constructor: original timing, looping, all frames
+	 */
+	ReplayCameraConfig() :
+		timing( Timing::Original ), fps( 30.0 ), loop( true ), max_frames( 0 ), raw_width( 0 ), raw_height( 0 ),
+		raw_format( PixelFormat::Mono8 ), temperature( 35.0 )
+	{
+	}
+};
+
+#endif // REPLAYCAMERACONFIG_H
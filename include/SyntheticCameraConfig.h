@@ -0,0 +1,33 @@
+#ifndef SYNTHETICCAMERACONFIG_H
+#define SYNTHETICCAMERACONFIG_H
+
+#include "PixelFormat.h"
+#include <cstdint>
+
+/**
+ * @struct SyntheticCameraConfig
+ * @brief Settings of a synthetic (in-process) camera
+ */
+struct SyntheticCameraConfig
+{
+	int width;				  ///< Frame width in pixels
+	int height;				  ///< Frame height in pixels
+	PixelFormat pixel_format; ///< Layout of the generated frames
+	double fps;				  ///< Nominal frames per second
+	double jitter_ms;		  ///< Maximum random extra delay per frame in ms
+	double temperature;		  ///< Temperature at start in °C
+	double temperature_drift; ///< Temperature change in °C per minute of acquisition
+	double temperature_max;	  ///< Temperature at which the drift saturates in °C
+	uint32_t seed;			  ///< Seed of the jitter generator, 0 for random
+
+	/**
+	 * @brief Default constructor: 1280x720 BGR at 30 FPS
+	 */
+	SyntheticCameraConfig() :
+		width( 1280 ), height( 720 ), pixel_format( PixelFormat::Bgr8 ), fps( 30.0 ), jitter_ms( 0.0 ), temperature( 35.0 ),
+		temperature_drift( 0.5 ), temperature_max( 60.0 ), seed( 0 )
+	{
+	}
+};
+
+#endif // SYNTHETICCAMERACONFIG_H
@@ -0,0 +1,42 @@
+#ifndef THREADPLACEMENTCONFIG_H
+#define THREADPLACEMENTCONFIG_H
+
+#include <QMap>
+#include <QVector>
+
+/**
+ * @struct ThreadPlacementConfig
+ * @brief Which CPU cores the threads working on each camera may run on
+ *
+ * Cameras are numbered by the slot of their ID (0, 1, 2, ... in the order
+ * they were added), which unlike camera IDs is stable across runs. Removing
+ * a camera does not renumber the others; the next camera added takes the
+ * free number.
+ */
+struct ThreadPlacementConfig
+{
+	/**
+	 * @enum Policy
+	 * @brief How cameras are assigned to cores
+	 */
+	enum class Policy
+	{
+		None,		 ///< Threads are left to the OS scheduler
+		RoundRobin,	 ///< Camera n gets the n-th usable core, wrapping around
+		PerNumaNode, ///< Camera n gets all usable cores of NUMA node n modulo the node count
+		Explicit	 ///< Cores listed per camera; cameras without an entry are not pinned
+	};
+
+	Policy policy;						   ///< Assignment policy
+	QVector<int> reserved_cores;		   ///< Cores never assigned (e.g. kept for the GUI)
+	QMap<int, QVector<int>> camera_cores; ///< Cores per camera number (Explicit)
+
+	/**
+	 * @brief Default constructor: no placement
+	 */
+	ThreadPlacementConfig() : policy( Policy::None )
+	{
+	}
+};
+
+#endif // THREADPLACEMENTCONFIG_H
@@ -0,0 +1,155 @@
+#include "cameraview.h"
+#include <QPainter>
+#include <QFontMetrics>
+#include <QEvent>
+
+namespace {
+const QColor kBackground(0x2b, 0x2b, 0x2b);
+const QColor kBorder(0x55, 0x55, 0x55);
+const QColor kPlaceholderText(0x99, 0x99, 0x99);
+}
+
+CameraView::CameraView(QWidget* parent)
+    : QWidget(parent)
+{
+    // every pixel is painted in paintEvent, Qt does not have to clear first
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    setContentsMargins(1, 1, 1, 1); // room for the border
+}
+
+void CameraView::setFrame(const QImage& image, double fps, double temperature)
+{
+    m_frame = image;
+    m_scaledValid = false;
+    m_placeholder.clear();
+
+    // the sprite is only rebuilt when the displayed text changes, not on every frame
+    const QString text = QString("FPS: %1\nTemp: %2 \u00B0C").arg(fps, 0, 'f', 1).arg(temperature, 0, 'f', 1);
+    if (text != m_overlayText) {
+        m_overlayText = text;
+        m_overlayValid = false;
+    }
+    update();
+}
+
+void CameraView::setPlaceholder(const QString& text)
+{
+    if (m_frame.isNull() && m_placeholder == text)
+        return;
+
+    m_frame = QImage();
+    m_scaled = QImage();
+    m_scaledValid = false;
+    m_placeholder = text;
+    update();
+}
+
+QSize CameraView::imageSize() const
+{
+    return contentsRect().size();
+}
+
+bool CameraView::isExposed() const
+{
+    // visibleRegion() is clipped by all ancestors, so it is empty outside the scroll viewport
+    return isVisible() && !window()->isMinimized() && !visibleRegion().isEmpty();
+}
+
+QSize CameraView::sizeHint() const
+{
+    return QSize(320, 240);
+}
+
+QSize CameraView::minimumSizeHint() const
+{
+    return QSize(320, 240);
+}
+
+void CameraView::resizeEvent(QResizeEvent* event)
+{
+    // the next frame is rendered for the new size, until then the current one is rescaled once
+    m_scaledValid = false;
+    QWidget::resizeEvent(event);
+}
+
+void CameraView::changeEvent(QEvent* event)
+{
+    if (event->type() == QEvent::FontChange)
+        m_overlayValid = false;
+    QWidget::changeEvent(event);
+}
+
+QRect CameraView::imageRect() const
+{
+    const QRect area = contentsRect();
+    if (m_frame.isNull())
+        return area;
+
+    const QSize size = m_frame.size().scaled(area.size(), Qt::KeepAspectRatio);
+    QRect rect(QPoint(0, 0), size);
+    rect.moveCenter(area.center());
+    return rect;
+}
+
+void CameraView::paintEvent(QPaintEvent* /*event*/)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), kBackground);
+
+    if (m_frame.isNull()) {
+        painter.setPen(kPlaceholderText);
+        painter.drawText(contentsRect(), Qt::AlignCenter, m_placeholder);
+    } else {
+        const QRect target = imageRect();
+        if (!m_scaledValid) {
+            // the renderer normally delivers the exact size, scaling is the exception after a resize
+            m_scaled = m_frame.size() == target.size()
+                ? m_frame
+                : m_frame.scaled(target.size(), Qt::IgnoreAspectRatio, Qt::FastTransformation);
+            m_scaledValid = true;
+        }
+        painter.drawImage(target.topLeft(), m_scaled);
+
+        // moving to a screen with another scale factor also needs a new sprite
+        if (!m_overlayValid || m_overlay.devicePixelRatio() != devicePixelRatioF())
+            renderOverlay();
+        const int margin = 6;
+        painter.drawImage(target.topLeft() + QPoint(margin, margin), m_overlay);
+    }
+
+    painter.setPen(kBorder);
+    painter.setBrush(Qt::NoBrush);
+    painter.drawRect(rect().adjusted(0, 0, -1, -1));
+}
+
+void CameraView::renderOverlay()
+{
+    // --- Overlay (top-left): FPS + Temperature ---
+    // drawn in widget space, so it stays readable whatever the frame resolution
+    QFont overlayFont = font();
+    overlayFont.setBold(true);
+
+    const QFontMetrics fm(overlayFont);
+    const int padding = 4;
+    const QRect textRect = fm.boundingRect(QRect(), Qt::AlignLeft | Qt::AlignTop, m_overlayText);
+    const QSize size = textRect.size() + QSize(2 * padding, 2 * padding);
+
+    // rendered at device resolution, so the sprite is blended without scaling
+    const qreal ratio = devicePixelRatioF();
+    m_overlay = QImage(size * ratio, QImage::Format_ARGB32_Premultiplied);
+    m_overlay.setDevicePixelRatio(ratio);
+    m_overlay.fill(Qt::transparent);
+
+    QPainter painter(&m_overlay);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 150));
+    painter.drawRoundedRect(QRect(QPoint(0, 0), size), 4, 4);
+
+    painter.setFont(overlayFont);
+    painter.setPen(Qt::white);
+    painter.drawText(QRect(QPoint(padding, padding), textRect.size()), Qt::AlignLeft | Qt::AlignTop, m_overlayText);
+
+    m_overlayValid = true;
+}
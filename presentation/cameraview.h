@@ -0,0 +1,64 @@
+#pragma once
+#include <QWidget>
+#include <QImage>
+#include <QString>
+
+/**
+ * @brief Tile showing the latest preview image of one camera
+ *
+ * Paints the image handed over by setFrame() directly in paintEvent(),
+ * centered with its aspect ratio kept, and draws the FPS / temperature
+ * overlay on top in widget coordinates. Unlike a QLabel with a pixmap, a
+ * new frame changes neither size hint nor layout and needs no QPixmap
+ * conversion; the widget repaints only on a new frame or a resize.
+ *
+ * The overlay is rendered once per change of its text into a small
+ * premultiplied ARGB sprite; every other frame only blends that sprite,
+ * which the raster paint engine does with its SIMD blend functions.
+ */
+class CameraView : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit CameraView(QWidget* parent = nullptr);
+
+    /// @brief shows a new frame; the image is kept (shared, not copied) until the next one
+    /// @param image preview image, ideally already of imageSize()
+    /// @param fps frame rate shown in the overlay
+    /// @param temperature sensor temperature shown in the overlay
+    void setFrame(const QImage& image, double fps, double temperature);
+
+    /// @brief drops the frame and shows a text instead, e.g. "No frame"
+    void setPlaceholder(const QString& text);
+
+    /// @brief size the preview image should be rendered at
+    QSize imageSize() const;
+
+    /// @brief true if some part of the view can be seen: not hidden, not scrolled
+    ///        out of its scroll area and the window not minimized
+    bool isExposed() const;
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void changeEvent(QEvent* event) override;
+
+private:
+    /// @brief area of the image within the widget, centered, aspect ratio kept
+    QRect imageRect() const;
+
+    /// @brief renders the overlay text box into m_overlay
+    void renderOverlay();
+
+private:
+    QImage m_frame;          ///< latest frame
+    QImage m_scaled;         ///< m_frame at imageRect() size, built on demand
+    bool m_scaledValid = false;
+    QString m_overlayText;   ///< text of the overlay, as displayed
+    QImage m_overlay;        ///< m_overlayText rendered, premultiplied ARGB
+    bool m_overlayValid = false;
+    QString m_placeholder = "Waiting...";
+};
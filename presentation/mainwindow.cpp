@@ -53,7 +53,11 @@ MainWindow::MainWindow(QWidget *parent)
     connect(ui->increaseWindowButton, &QPushButton::clicked,this, &MainWindow::onIncreaseGraphWindowTriggered);
     connect(ui->decreaseWindowButton, &QPushButton::clicked,this, &MainWindow::onDecreaseGraphWindowTriggered);
 
-    connect(m_cameraManager, &CamerasManager::framesUpdated, this, &MainWindow::updateFrame);
+    m_previewRenderer = new PreviewRenderer(m_cameraManager->executor(), this);
+    // the display has its own clock; acquisition and recording run at the cameras' rates
+    m_presentationScheduler = new PresentationScheduler(this, this);
+    connect(m_presentationScheduler, &PresentationScheduler::present, this, &MainWindow::updateFrame);
+    connect(m_previewRenderer, &PreviewRenderer::previewReady, this, &MainWindow::onPreviewReady);
 
     connect(m_cameraManager, &CamerasManager::cameraAdded, this, [this](int cameraId){
         if (!m_cameraDisplayNames.contains(cameraId)) {
@@ -63,6 +67,7 @@ MainWindow::MainWindow(QWidget *parent)
     });
 
     connect(m_cameraManager, &CamerasManager::cameraRemoved, this, [this](int cameraId){
+        m_previewRenderer->removeCamera(cameraId);
         removeCameraTile(cameraId);
     });
 
@@ -101,9 +106,9 @@ MainWindow::MainWindow(QWidget *parent)
     setupLogFile();
     // Camera Manager setup ------
     //m_cameraManager->addCamera();
-    m_cameraManager->setAutoUpdate(true, 33); // ~30fps
-    m_cameraManager->connectAll();
-    m_cameraManager->startAll();
+    m_cameraManager->setAutoUpdate(true, 33); // frame dispatch, shortened for fast cameras
+    m_presentationScheduler->start();
+    m_cameraManager->startAllAsync(); // cameras come up concurrently, the window stays responsive
 
     setupFpsGraph();
     setupTemperatureGraph();
@@ -145,6 +150,8 @@ MainWindow::MainWindow(QWidget *parent)
 }
 
 MainWindow::~MainWindow() {
+    // renders still running use the camera manager's executor, finish them first
+    delete m_previewRenderer;
     delete ui;
 }
 
@@ -288,6 +295,14 @@ void MainWindow::loadPersistentSettings()
 {
     QSettings settings("HTWBerlin", "MultiCamManager");
 
+    // Core placement of the camera threads, before any camera exists
+    m_cameraManager->setThreadPlacement(ThreadPlacement::loadConfig(settings));
+    m_cameraManager->setRealtimeScheduling(RealtimeScheduling::loadConfig(settings));
+
+    // Preview refresh cap in Hz, 0 follows the monitor's refresh rate
+    m_presentationScheduler->setMaxFps(
+        settings.value("display/maxFps", PresentationScheduler::kDefaultMaxFps).toDouble());
+
     // Load last Video output directory
     QString default_dir = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
     m_last_Output_dir = settings.value("lastOutputDir", default_dir).toString();
@@ -482,18 +497,12 @@ void MainWindow::ensureCameraTile(int cameraId)
     titleLabel->setAlignment(Qt::AlignCenter);
     titleLabel->setStyleSheet("font-weight: 600; color:#ddd; padding:4px;");
 
-    auto *imageLabel = new QLabel(tile);
-    imageLabel->setAlignment(Qt::AlignCenter);
-    imageLabel->setMinimumSize(320, 240);
-    imageLabel->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    imageLabel->setScaledContents(false);
-    imageLabel->setStyleSheet("background:#2b2b2b; border:1px solid #555; border-radius:4px; color:#999;");
-    imageLabel->setText("Waiting...");
+    auto *view = new CameraView(tile);
 
     tileLayout->addWidget(titleLabel);
-    tileLayout->addWidget(imageLabel);
+    tileLayout->addWidget(view);
 
-    m_cameraTiles.insert(cameraId, {tile, titleLabel, imageLabel});
+    m_cameraTiles.insert(cameraId, {tile, titleLabel, view});
 
     updateCameraTitle(cameraId);
     rebuildCameraGrid();
@@ -511,6 +520,7 @@ void MainWindow::removeCameraTile(int cameraId)
     }
 
     const CameraTile tile = m_cameraTiles.take(cameraId);
+    m_exposedTiles.remove(cameraId);
     if (tile.container) {
         ui->cameraGridLayout->removeWidget(tile.container);
         tile.container->deleteLater();
@@ -552,86 +562,59 @@ void MainWindow::rebuildCameraGrid()
 }
 
 void MainWindow::updateFrame() {
-    const QMap<int, cv::Mat> allFrames = m_cameraManager->getAllFrames();
+    // A recording that falls behind gets the CPU: the preview refreshes less often instead
+    ++m_previewTick;
+    if (m_cameraManager->isRecordingBackedUp() && m_previewTick % kBackedUpPreviewDivisor != 0) {
+        return;
+    }
+
+    // newest frame of each camera, however many arrived since the last tick
+    const QMap<int, FramePacketPtr> allPackets = m_cameraManager->getLatestPackets();
     const QVector<int> cameraIds = m_cameraManager->getCameraIds();
 
     for (int id : cameraIds) {
         ensureCameraTile(id);
-        updateCameraTitle(id);
     }
 
+    // Conversion and scaling run on the executor; onPreviewReady() only hands
+    // the finished tile image to its view.
+    // Tiles nobody can see (toggled off, scrolled away, window minimized) cost nothing;
+    // recording and logging are fed by the camera manager and do not depend on this.
     for (auto it = m_cameraTiles.begin(); it != m_cameraTiles.end(); ++it) {
-        const int cameraId = it.key();
-        CameraTile &tile = it.value();
-
-        if (!tile.imageLabel) {
+        const CameraTile &tile = it.value();
+        if (!tile.view) {
             continue;
         }
 
-        const auto frameIt = allFrames.find(cameraId);
-        if (frameIt != allFrames.end() && !frameIt.value().empty()) {
-            cv::Mat frameRgb;
-            cv::cvtColor(frameIt.value(), frameRgb, cv::COLOR_BGR2RGB);
-
-            // NOTE: QImage uses the cv::Mat buffer here. We copy() before painting to ensure
-            // the image has its own storage and is safe to modify.
-            QImage img(
-                frameRgb.data,
-                frameRgb.cols,
-                frameRgb.rows,
-                static_cast<int>(frameRgb.step),
-                QImage::Format_RGB888
-                );
-            img = img.copy();
-
-            // --- Overlay (top-left): FPS + Temperature ---
-            // Values are provided by the simulator via Camera::getParameters().
-            const CameraParameters params = m_cameraManager->getCameraParameters(cameraId);
-            {
-                QPainter painter(&img);
-                painter.setRenderHint(QPainter::Antialiasing);
-
-                QFont font = painter.font();
-                font.setPointSize(30);
-                font.setBold(true);
-                painter.setFont(font);
-
-                const int margin = 8;
-                const int lineH = 35;
-
-                const QString line1 = QString("FPS: %1").arg(params.fps, 0, 'f', 1);
-                const QString line2 = QString("Temp: %1 \u00B0C").arg(params.temperature, 0, 'f', 1);
-
-                // Background box sized to content (simple, robust sizing)
-                QFontMetrics fm(font);
-                const int w = std::max(fm.horizontalAdvance(line1), fm.horizontalAdvance(line2)) + 16;
-                const int h = (lineH * 2) + 12;
-                QRect bg(margin - 4, margin - 4, w, h);
-
-                painter.setPen(Qt::NoPen);
-                painter.setBrush(QColor(0, 0, 0, 150));
-                painter.drawRoundedRect(bg, 4, 4);
-
-                painter.setPen(Qt::white);
-                painter.drawText(margin, margin + lineH, line1);
-                painter.drawText(margin, margin + 2 * lineH, line2);
+        if (!tile.view->isExposed()) {
+            if (m_exposedTiles.remove(it.key())) {
+                m_previewRenderer->suspend(it.key());
+                tile.view->setPlaceholder("Waiting..."); // releases the frame
             }
+            continue;
+        }
+        m_exposedTiles.insert(it.key());
 
-            QPixmap pix = QPixmap::fromImage(img);
-            pix = pix.scaled(
-                tile.imageLabel->size(),
-                Qt::KeepAspectRatio,
-                Qt::SmoothTransformation
-                );
-            tile.imageLabel->setPixmap(pix);
-            tile.imageLabel->setText(QString());
+        const FramePacketPtr packet = allPackets.value(it.key());
+        if (packet && !packet->frame.empty()) {
+            m_previewRenderer->render(it.key(), packet, tile.view->imageSize());
         } else {
-            tile.imageLabel->setPixmap(QPixmap());
-            tile.imageLabel->setText("No frame");
+            tile.view->setPlaceholder("No frame");
         }
     }
 }
 
+void MainWindow::onPreviewReady(int cameraId, const QImage &image, double fps, double temperature)
+{
+    // a render may finish after its tile was hidden
+    const auto it = m_cameraTiles.constFind(cameraId);
+    if (it == m_cameraTiles.constEnd() || !it->view || !m_exposedTiles.contains(cameraId)) {
+        return;
+    }
+
+    it->view->setFrame(image, fps, temperature);
+}
+
 
 QColor MainWindow::colorForCamera(int cameraId)
 {
@@ -10,12 +10,16 @@
 #include <QTimer>
 #include <QVector>
 #include <QMap>
+#include <QSet>
 #include <QGridLayout>
 #include <QLabel>
 #include <opencv2/opencv.hpp>
 #include <QSettings>
 
 #include "CamerasManager.h"
+#include "PreviewRenderer.h"
+#include "cameraview.h"
+#include "presentationscheduler.h"
 
 #include <QListWidget>
 #include <QComboBox>
@@ -58,7 +62,7 @@ private:
 	struct CameraTile {
 		QWidget* container = nullptr;
 		QLabel* titleLabel = nullptr;
-		QLabel* imageLabel = nullptr;
+		CameraView* view = nullptr;
 	};
 
 	void rebuildCameraGrid();
@@ -70,6 +74,15 @@ private:
 private slots:
 	void updateFrame();
 
+	/**
+	 * @brief Show a preview finished by the PreviewRenderer
+	 * @param cameraId Camera ID
+	 * @param image Tile-sized image
+	 * @param fps Frame rate for the overlay
+	 * @param temperature Sensor temperature for the overlay
+	 */
+	void onPreviewReady(int cameraId, const QImage &image, double fps, double temperature);
+
     /**
      * @brief Triggered when the record action is activated.
      *
@@ -237,6 +250,8 @@ private:
 	Ui::MainWindow *ui;
 
 	CamerasManager *m_cameraManager;
+	PreviewRenderer *m_previewRenderer; ///< Renders the tiles off the GUI thread
+	PresentationScheduler *m_presentationScheduler; ///< Display clock driving updateFrame()
 
     bool m_camerasPanelOpen = false;
     double m_camerasPanelWidthFactor = 0.20;   // 20% der Fensterbreite
@@ -278,6 +293,10 @@ private:
 
 
 	QMap<int, CameraTile> m_cameraTiles;
+	QSet<int> m_exposedTiles; ///< Tiles that could be seen at the last updateFrame()
 	int m_cameraGridColumns = 2;
+
+	static constexpr int kBackedUpPreviewDivisor = 4; ///< Preview refreshes only every n-th tick while recording is behind
+	int m_previewTick = 0;                            ///< Counts updateFrame() calls for the reduced preview
 };
 #endif // MAINWINDOW_H
@@ -0,0 +1,67 @@
+#include "presentationscheduler.h"
+#include <QGuiApplication>
+#include <QScreen>
+#include <QWidget>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+PresentationScheduler::PresentationScheduler(QWidget* window, QObject* parent)
+    : QObject(parent), m_window(window)
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &PresentationScheduler::onTimeout);
+    updateRate();
+}
+
+void PresentationScheduler::setMaxFps(double fps)
+{
+    m_maxFps = std::max(fps, 0.0);
+    updateRate();
+}
+
+void PresentationScheduler::start()
+{
+    updateRate();
+    m_timer.start();
+}
+
+void PresentationScheduler::stop()
+{
+    m_timer.stop();
+}
+
+void PresentationScheduler::onTimeout()
+{
+    // the window may have been moved to a screen with another refresh rate
+    if (currentScreen() != m_screen)
+        updateRate();
+
+    emit present();
+}
+
+QScreen* PresentationScheduler::currentScreen() const
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    if (m_window && m_window->screen())
+        return m_window->screen();
+#endif
+    return QGuiApplication::primaryScreen();
+}
+
+void PresentationScheduler::updateRate()
+{
+    m_screen = currentScreen();
+
+    double refresh = m_screen ? m_screen->refreshRate() : 0.0;
+    if (refresh <= 0.0)
+        refresh = kFallbackRefresh;
+
+    const double rate = m_maxFps > 0.0 ? std::min(refresh, m_maxFps) : refresh;
+    const int intervalMs = std::max(1, static_cast<int>(std::lround(1000.0 / rate)));
+    if (intervalMs != m_timer.interval() || rate != m_rate) {
+        m_rate = rate;
+        m_timer.setInterval(intervalMs);
+        qDebug() << "[Presentation] refreshing previews at" << rate << "Hz (screen" << refresh << "Hz)";
+    }
+}
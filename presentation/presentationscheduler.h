@@ -0,0 +1,57 @@
+#pragma once
+#include <QObject>
+#include <QTimer>
+#include <QPointer>
+
+class QScreen;
+class QWidget;
+
+/**
+ * @brief Display clock of the camera grid, independent of acquisition
+ *
+ * Emits present() at the refresh rate of the screen the window is on, or
+ * at a configurable lower cap. Acquisition, dispatch and recording keep
+ * running at each camera's own rate; a present() tick only shows the newest
+ * frame available at that moment, so a 120 fps camera costs no more
+ * repaints than a 30 fps one.
+ */
+class PresentationScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr double kDefaultMaxFps = 30.0;   ///< cap used unless configured
+    static constexpr double kFallbackRefresh = 60.0; ///< used if the screen reports no rate
+
+    /// @param window window whose screen sets the refresh rate
+    explicit PresentationScheduler(QWidget* window, QObject* parent = nullptr);
+
+    /// @brief limits the presentation rate
+    /// @param fps upper bound in Hz, 0 to follow the screen's refresh rate
+    void setMaxFps(double fps);
+    double maxFps() const { return m_maxFps; }
+
+    /// @brief rate present() is currently emitted at, in Hz
+    double rate() const { return m_rate; }
+
+    void start();
+    void stop();
+
+signals:
+    /// @brief time to show the newest frames
+    void present();
+
+private:
+    void onTimeout();
+
+    /// @brief derives the timer interval from screen and cap
+    void updateRate();
+
+    QScreen* currentScreen() const;
+
+private:
+    QWidget* m_window;
+    QTimer m_timer;
+    QPointer<QScreen> m_screen; ///< screen the rate was derived from
+    double m_maxFps = kDefaultMaxFps;
+    double m_rate = kDefaultMaxFps;
+};